@@ -0,0 +1,156 @@
+/**
+ * @file BroadcastBench.cpp
+ * @brief Coût de la diffusion d'une session aux observateurs selon leur nombre
+ *
+ * Usage: BroadcastBench [--messages <n>] [--max-observers <n>]
+ * Pour 0, 1, 2, 4… observateurs, mesure le coût d'un send() côté jeu et le
+ * temps de livraison à tous; le coût par observateur doit rester stable.
+ */
+#include "UdsTransport.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <print>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Résultat d'une mesure pour un nombre d'observateurs
+ */
+struct Round {
+    size_t observers;   ///< Nombre d'observateurs attachés
+    double sendNs;      ///< Coût moyen d'un send() (thread de jeu)
+    double deliverNs;   ///< Temps moyen de livraison à tous, par message
+    double perObserver; ///< Temps de livraison par message et observateur
+};
+
+/**
+ * @brief Connecte un client UDS
+ * @param path Chemin de la socket
+ * @return Descripteur, -1 en cas d'échec
+ */
+int connectTo(const std::string& path) {
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    path.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+    if (connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+/**
+ * @brief Lit et compte les octets reçus jusqu'à la fermeture
+ * @param fd Socket à vider
+ * @param bytes Compteur d'octets reçus
+ */
+void drain(int fd, std::atomic<size_t>& bytes) {
+    char buffer[65536];
+    ssize_t n;
+    while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) bytes += n;
+}
+
+/**
+ * @brief Attend qu'une condition soit vraie (au plus 10 s)
+ * @param done Condition attendue
+ * @return true si la condition est devenue vraie
+ */
+template <typename Predicate> bool waitUntil(Predicate done) {
+    auto limit = Clock::now() + std::chrono::seconds(10);
+    while (!done() && Clock::now() < limit) std::this_thread::yield();
+    return done();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t messages = 20000;
+    size_t maxObservers = 32;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--messages" && i + 1 < argc)
+            messages = std::stoul(argv[++i]);
+        else if (arg == "--max-observers" && i + 1 < argc)
+            maxObservers = std::stoul(argv[++i]);
+        else {
+            std::println(stderr, "Usage: {} [--messages <n>] "
+                                 "[--max-observers <n>]",
+                         argv[0]);
+            return 1;
+        }
+    }
+    const std::string path = "/tmp/smartpiano-bench.sock";
+    UdsTransport transport(path);
+    // Mesure de la diffusion seule: ni délestage ni coupure
+    transport.setBackpressure(
+        {.maxQueued = SIZE_MAX, .disconnectAfter = SIZE_MAX});
+    transport.enableObservers(path + ".watch");
+    if (!transport.start()) return 1;
+    std::atomic<size_t> studentBytes{0};
+    std::thread student([&]() {
+        int fd = connectTo(path);
+        if (fd >= 0) drain(fd, studentBytes);
+        close(fd);
+    });
+    transport.waitForClient();
+
+    Message msg("result",
+                {{"id", "1"}, {"correct", "c4 e4 g4"}, {"duration", "812"}});
+    const size_t frame = UdsTransport::serializeMessage(msg).size();
+    std::vector<Round> rounds;
+    for (size_t n = 0; n <= maxObservers; n = n ? n * 2 : 1) {
+        std::vector<int> fds;
+        std::vector<std::atomic<size_t>> received(n);
+        std::vector<std::thread> readers;
+        for (size_t i = 0; i < n; ++i) {
+            fds.push_back(connectTo(path + ".watch"));
+            readers.emplace_back(drain, fds.back(), std::ref(received[i]));
+        }
+        waitUntil([&] { return transport.getStats().observers == n; });
+        size_t studentTarget = studentBytes + messages * frame;
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < messages; ++i) transport.send(msg);
+        auto sent = Clock::now();
+        bool complete = waitUntil([&] {
+            for (const auto& bytes : received)
+                if (bytes < messages * frame) return false;
+            return studentBytes >= studentTarget;
+        });
+        auto delivered = Clock::now();
+        if (!complete) std::println(stderr, "Livraison incomplète ({})", n);
+
+        for (int fd : fds) shutdown(fd, SHUT_RDWR);
+        for (auto& reader : readers) reader.join();
+        for (int fd : fds) close(fd);
+        waitUntil([&] { return transport.getStats().observers == 0; });
+
+        auto perMessage = [&](Clock::duration d) {
+            return std::chrono::duration<double, std::nano>(d).count() /
+                   static_cast<double>(messages);
+        };
+        double deliverNs = perMessage(delivered - start);
+        rounds.push_back({n, perMessage(sent - start), deliverNs,
+                          n ? deliverNs / static_cast<double>(n) : 0.0});
+    }
+    transport.stop();
+    student.join();
+
+    std::println("{} messages de {} octets par mesure", messages, frame);
+    std::println("{:>12} {:>14} {:>16} {:>18}", "observateurs", "ns/send",
+                 "ns/msg livré", "ns/msg/observateur");
+    for (const auto& r : rounds)
+        std::println("{:>12} {:>14.0f} {:>16.0f} {:>18.0f}", r.observers,
+                     r.sendNs, r.deliverNs, r.perObserver);
+    return 0;
+}
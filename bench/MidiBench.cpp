@@ -0,0 +1,88 @@
+/**
+ * @file MidiBench.cpp
+ * @brief Coût de la conversion numéro MIDI → Note (ancienne et nouvelle)
+ *
+ * Usage: MidiBench [--min-time <ms>]
+ * Compare la recherche std::map d'origine, suivie de toString(), à la table
+ * calculée à la compilation (MidiNotes.hpp), sur les 108 notes jouables.
+ */
+#include "MidiNotes.hpp"
+#include "Note.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <print>
+#include <string>
+#include <string_view>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+volatile size_t sink{0}; ///< Empêche l'optimiseur d'éliminer les appels
+
+/**
+ * @brief Répète une opération jusqu'à la durée minimale et affiche son coût
+ * @param name Nom du cas mesuré
+ * @param minTime Durée minimale de mesure
+ * @param op Opération mesurée (une conversion), absorbée par `sink`
+ */
+void measure(std::string_view name, std::chrono::milliseconds minTime,
+             const std::function<size_t(uint8_t)>& op) {
+    uint64_t iterations = 0;
+    auto start = Clock::now();
+    auto elapsed = Clock::duration::zero();
+    // Lots croissants pour limiter le coût de lecture de l'horloge
+    for (uint64_t batch = 1; elapsed < minTime; batch *= 2) {
+        for (uint64_t i = 0; i < batch; ++i)
+            sink = sink + op(static_cast<uint8_t>(12 + i % 108));
+        iterations += batch;
+        elapsed = Clock::now() - start;
+    }
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count() /
+                static_cast<double>(iterations);
+    std::println("{:<28} {:>10.1f} ns/note", name, ns);
+}
+
+/**
+ * @brief Conversion d'origine de RtMidiInput (avant la table constexpr)
+ * @param midiNote Numéro MIDI (12-119)
+ * @return Note correspondante
+ */
+Note mapConversion(int midiNote) {
+    static const std::map<int, std::string> noteNames = {
+        {0, "c"},  {1, "c#"}, {2, "d"},  {3, "d#"}, {4, "e"},   {5, "f"},
+        {6, "f#"}, {7, "g"},  {8, "g#"}, {9, "a"},  {10, "a#"}, {11, "b"}};
+    int octave = (midiNote / 12) - 1;
+    auto it = noteNames.find(midiNote % 12);
+    return Note(it->second, octave);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::chrono::milliseconds minTime{200};
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--min-time" && i + 1 < argc) {
+            minTime = std::chrono::milliseconds(std::stoi(argv[++i]));
+        } else {
+            std::println(stderr, "Usage: {} [--min-time <ms>]", argv[0]);
+            return 1;
+        }
+    }
+    std::println("== Note ==");
+    measure("std::map", minTime,
+            [](uint8_t midi) { return mapConversion(midi).toMidi(); });
+    measure("midiToNote", minTime,
+            [](uint8_t midi) { return midiToNote(midi).toMidi(); });
+
+    std::println("== Note + toString() ==");
+    measure("std::map", minTime,
+            [](uint8_t midi) { return mapConversion(midi).toString().size(); });
+    measure("MIDI_NOTE_NAMES", minTime, [](uint8_t midi) {
+        return MIDI_NOTE_NAMES[midi].str().size();
+    });
+    return 0;
+}
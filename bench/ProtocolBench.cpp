@@ -0,0 +1,111 @@
+/**
+ * @file ProtocolBench.cpp
+ * @brief Débit du codec du protocole UDS (sérialisation, découpage, parsing)
+ *
+ * Usage: ProtocolBench [--min-time <ms>] [--write-corpus <dossier>]
+ * Chaque cas du corpus est répété jusqu'à la durée minimale, puis le débit est
+ * rapporté en messages/s et en octets/s.
+ */
+#include "ProtocolCorpus.hpp"
+#include "UdsTransport.hpp"
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+volatile size_t sink{0}; ///< Empêche l'optimiseur d'éliminer les appels
+
+/**
+ * @brief Répète une opération jusqu'à la durée minimale et affiche le débit
+ * @param name Nom du cas mesuré
+ * @param bytes Octets traités par itération
+ * @param minTime Durée minimale de mesure
+ * @param op Opération mesurée, retourne une valeur absorbée par `sink`
+ */
+void measure(std::string_view name, size_t bytes,
+             std::chrono::milliseconds minTime,
+             const std::function<size_t()>& op) {
+    uint64_t iterations = 0;
+    auto start = Clock::now();
+    auto elapsed = Clock::duration::zero();
+    // Lots croissants pour limiter le coût de lecture de l'horloge
+    for (uint64_t batch = 1; elapsed < minTime; batch *= 2) {
+        for (uint64_t i = 0; i < batch; ++i) sink = sink + op();
+        iterations += batch;
+        elapsed = Clock::now() - start;
+    }
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    double msgs = static_cast<double>(iterations) / seconds;
+    std::println("{:<28} {:>12.0f} msg/s {:>10.2f} Mo/s {:>10.1f} ns/msg",
+                 name, msgs, msgs * static_cast<double>(bytes) / 1e6,
+                 1e9 / msgs);
+}
+
+/**
+ * @brief Écrit le corpus, un fichier par cas (graines pour le fuzzer)
+ * @param dir Dossier de destination (existant)
+ */
+void writeCorpus(const std::string& dir) {
+    for (const auto& [name, data] : protocolCorpus()) {
+        std::ofstream out(dir + "/" + name, std::ios::binary);
+        out << data;
+    }
+    std::println("Corpus écrit dans {}", dir);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::chrono::milliseconds minTime{200};
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--min-time" && i + 1 < argc)
+            minTime = std::chrono::milliseconds(std::stoi(argv[++i]));
+        else if (arg == "--write-corpus" && i + 1 < argc) {
+            writeCorpus(argv[++i]);
+            return 0;
+        } else {
+            std::println(stderr, "Usage: {} [--min-time <ms>] "
+                                 "[--write-corpus <dossier>]",
+                         argv[0]);
+            return 1;
+        }
+    }
+    auto corpus = protocolCorpus();
+
+    std::println("== parseMessage ==");
+    for (const auto& [name, data] : corpus)
+        measure(name, data.size(), minTime, [&data] {
+            return UdsTransport::parseMessage(data).getFields().size();
+        });
+
+    std::println("== serializeMessage ==");
+    for (const auto& [name, data] : corpus) {
+        Message msg = UdsTransport::parseMessage(data);
+        size_t bytes = UdsTransport::serializeMessage(msg).size();
+        measure(name, bytes, minTime, [&msg] {
+            return UdsTransport::serializeMessage(msg).size();
+        });
+    }
+
+    // Chemin de réception complet: tampon de flux → messages
+    std::println("== extractFrame + parseMessage ==");
+    for (const auto& [name, data] : corpus)
+        measure(name, data.size(), minTime, [&data] {
+            std::string buffer = data;
+            std::string frame;
+            size_t fields = 0;
+            while (UdsTransport::extractFrame(buffer, frame))
+                fields += UdsTransport::parseMessage(frame).getFields().size();
+            return fields;
+        });
+    return 0;
+}
@@ -0,0 +1,51 @@
+#ifndef PROTOCOLCORPUS_HPP
+#define PROTOCOLCORPUS_HPP
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Corpus de messages bruts du protocole, réalistes et hostiles
+ * Partagé par le banc d'essai et le fuzzer (graines)
+ * @return Paires (nom, octets reçus)
+ */
+inline std::vector<std::pair<std::string, std::string>> protocolCorpus() {
+    std::vector<std::pair<std::string, std::string>> corpus = {
+        // Messages réalistes, dans les deux sens
+        {"config", "config\ngame=note\nscale=c\nmode=maj\n\n"},
+        {"ready", "ready\n\n"},
+        {"quit", "quit\n\n"},
+        {"note", "note\nnote=c4\nid=1\n\n"},
+        {"chord", "chord\nname=Do majeur\nnotes=c4 e4 g4\nid=5\n\n"},
+        {"result",
+         "result\nid=2\ncorrect=c4 e4\nincorrect=f4\nduration=812\n\n"},
+        {"over", "over\nduration=45\nperfect=10\ntotal=10\n\n"},
+        {"gametype", "gametype\nid=inversed\nname=Jeu d'accords renversés\n"
+                     "keys=14\n\n"},
+        {"ping", "ping\nid=42\n\n"},
+        // Cas limites
+        {"crlf", "config\r\ngame=chord\r\nscale=d\r\nmode=min\r\n\r\n"},
+        {"utf8",
+         "error\ncode=midi\nmessage=Périphérique indisponible ♪ ⚠ 🎹\n\n"},
+        {"no_terminator", "config\ngame=note\nscale=c"},
+        {"no_type", "\nkey=val\n\n"},
+        {"empty", "\n\n"},
+        {"no_equal", "TEST\nnotakeyvalue\n\n"},
+        {"equal_in_value", "TEST\nkey=a=b=c\n\n"},
+        {"two_messages", "ready\n\nquit\n\n"},
+        {"duplicate_key", "TEST\nk=1\nk=2\n\n"},
+    };
+    // Valeur très longue (64 Kio)
+    corpus.emplace_back("long_value", "result\nincorrect=" +
+                                          std::string(65536, 'x') + "\n\n");
+    // Nombreux champs
+    std::string manyFields = "config\n";
+    for (int i = 0; i < 256; ++i)
+        manyFields += "field_" + std::to_string(i) + "=" + std::to_string(i) +
+                      "\n";
+    corpus.emplace_back("many_fields", manyFields + "\n");
+    return corpus;
+}
+
+#endif // PROTOCOLCORPUS_HPP
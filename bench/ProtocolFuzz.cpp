@@ -0,0 +1,84 @@
+/**
+ * @file ProtocolFuzz.cpp
+ * @brief Point d'entrée libFuzzer sur le codec du protocole UDS
+ *
+ * Avec -DFUZZING=ON (clang): ./ProtocolFuzz corpus/ (graines produites par
+ * ProtocolBench --write-corpus corpus/).
+ * Sinon, un main rejoue le corpus intégré (test de non-régression ctest).
+ */
+#include "ProtocolCorpus.hpp"
+#include "UdsTransport.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <print>
+#include <string>
+
+namespace {
+
+/**
+ * @brief Interrompt l'exécution si un invariant du codec est violé
+ * @param ok Invariant vérifié
+ * @param what Description de l'invariant
+ */
+void require(bool ok, const char* what) {
+    if (ok) return;
+    std::println(stderr, "[ProtocolFuzz] Invariant violé: {}", what);
+    std::abort();
+}
+
+/**
+ * @brief Un message est-il représentable à l'identique par le protocole?
+ * Un `\r` final est retiré à la lecture, il ne peut donc pas survivre
+ * @param msg Message parsé
+ * @return true si sérialiser puis parser doit redonner le même message
+ */
+bool representable(const Message& msg) {
+    if (msg.getType().empty() || msg.getType().back() == '\r') return false;
+    for (const auto& [key, value] : msg.getFields())
+        if (!value.empty() && value.back() == '\r') return false;
+    return true;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const std::string input(reinterpret_cast<const char*>(data), size);
+    std::string buffer = input;
+    std::string frame;
+    std::string consumed;
+    while (UdsTransport::extractFrame(buffer, frame)) {
+        // Découpage: concaténation des messages + reste = flux d'origine
+        require(!frame.empty(), "message extrait vide");
+        require(frame.ends_with("\n\n") || frame.ends_with("\n\r\n"),
+                "message extrait sans ligne vide finale");
+        consumed += frame;
+        // Aller-retour: parse ∘ serialize ∘ parse = parse
+        Message msg = UdsTransport::parseMessage(frame);
+        if (!representable(msg)) continue;
+        std::string wire = UdsTransport::serializeMessage(msg);
+        std::string rest = wire;
+        std::string again;
+        require(UdsTransport::extractFrame(rest, again) && rest.empty(),
+                "message sérialisé non découpable en un seul message");
+        Message back = UdsTransport::parseMessage(again);
+        require(back.getType() == msg.getType(), "type perdu");
+        require(back.getFields() == msg.getFields(), "champs perdus");
+    }
+    require(consumed + buffer == input, "octets perdus au découpage");
+    // Le tampon restant (message incomplet) est lui aussi parsable sans crash
+    UdsTransport::parseMessage(buffer);
+    return 0;
+}
+
+#ifndef FUZZING
+int main() {
+    auto corpus = protocolCorpus();
+    for (const auto& [name, data] : corpus)
+        LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t*>(data.data()),
+                               data.size());
+    std::println("[ProtocolFuzz] {} entrées rejouées sans erreur",
+                 corpus.size());
+    return 0;
+}
+#endif
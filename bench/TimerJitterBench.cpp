@@ -0,0 +1,101 @@
+/**
+ * @file TimerJitterBench.cpp
+ * @brief Gigue des réveils du minuteur d'accord, sans puis avec RealtimePolicy
+ *
+ * Usage: TimerJitterBench [--wakeups <n>] [--period <ms>] [--load <threads>]
+ *                         [--priority <1-99>] [--rr] [--cpu <n>]
+ * Reproduit l'attente de RtMidiInput::finalizeChords (poll() sur un Waker
+ * jusqu'à l'échéance de l'accord) pendant que des threads saturent les
+ * cœurs, et mesure le retard de chaque réveil sur son échéance.
+ */
+#include "LatencyHistogram.hpp"
+#include "RealtimePolicy.hpp"
+#include "Waker.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <poll.h>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Mesure le retard des réveils à échéance d'un thread minuteur
+ * @param policy Ordonnancement du thread minuteur
+ * @param wakeups Nombre d'échéances attendues
+ * @param period Intervalle entre deux échéances
+ * @return Histogramme des retards
+ */
+LatencyHistogram measure(const RealtimePolicy& policy, int wakeups,
+                         std::chrono::milliseconds period) {
+    LatencyHistogram lateness;
+    std::thread timer([&] {
+        applyRealtimePolicy(policy, "TimerJitterBench");
+        Waker wake; // Jamais signalé: réveil par le délai de poll()
+        for (int i = 0; i < wakeups; ++i) {
+            auto deadline = Clock::now() + period;
+            auto left = std::chrono::ceil<std::chrono::milliseconds>(
+                deadline - Clock::now());
+            pollfd pfd{wake.fd(), POLLIN, 0};
+            poll(&pfd, 1, static_cast<int>(left.count()));
+            lateness.record(Clock::now() - deadline);
+        }
+    });
+    timer.join();
+    return lateness;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int wakeups = 1000;
+    std::chrono::milliseconds period{2};
+    unsigned load = std::max(1u, std::thread::hardware_concurrency());
+    RealtimePolicy realtime{.priority = 50};
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--wakeups" && i + 1 < argc) {
+            wakeups = std::atoi(argv[++i]);
+        } else if (arg == "--period" && i + 1 < argc) {
+            period = std::chrono::milliseconds(std::atoi(argv[++i]));
+        } else if (arg == "--load" && i + 1 < argc) {
+            load = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (arg == "--priority" && i + 1 < argc) {
+            realtime.priority = std::atoi(argv[++i]);
+        } else if (arg == "--rr") {
+            realtime.roundRobin = true;
+        } else if (arg == "--cpu" && i + 1 < argc) {
+            realtime.cpu = std::atoi(argv[++i]);
+        } else {
+            std::println(stderr,
+                         "Usage: {} [--wakeups <n>] [--period <ms>] "
+                         "[--load <threads>] [--priority <1-99>] [--rr] "
+                         "[--cpu <n>]",
+                         argv[0]);
+            return 1;
+        }
+    }
+    // Charge concurrente: journalisation, interface, autres sessions…
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> busy;
+    for (unsigned i = 0; i < load; ++i)
+        busy.emplace_back([&stop] {
+            volatile uint64_t spin = 0;
+            while (!stop.load(std::memory_order_relaxed)) spin = spin + 1;
+        });
+    std::println("{} réveils toutes les {} ms, {} thread(s) de charge",
+                 wakeups, period.count(), load);
+    std::println("{:<16} {}", "normal", measure({}, wakeups, period).summary());
+    std::println("{:<16} {}", realtime.roundRobin ? "SCHED_RR" : "SCHED_FIFO",
+                 measure(realtime, wakeups, period).summary());
+    stop = true;
+    for (std::thread& thread : busy) thread.join();
+    return 0;
+}
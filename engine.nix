@@ -38,6 +38,7 @@ stdenv.mkDerivation {
     cp --verbose src/libenginecomm.a $out/lib/
     mkdir --parents --verbose $out/bin
     cp --verbose src/main $out/bin/engine
+    cp --verbose src/spload $out/bin/spload
     runHook postInstall
   '';
 }
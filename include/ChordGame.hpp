@@ -15,12 +15,15 @@
  */
 class ChordGame : public IGameMode {
   private:
-    ITransport& transport;     ///< Référence au transport
-    IMidiInput& midi;          ///< Référence à l'entrée MIDI
-    ChallengeFactory& factory; ///< Référence à la factory
-    GameConfig config;         ///< Configuration du jeu
-    bool withInversions;       ///< Mode avec renversements?
-    int challengeId;           ///< ID du challenge actuel
+    ITransport& transport;           ///< Référence au transport
+    IMidiInput& midi;                ///< Référence à l'entrée MIDI
+    ChallengeFactory& factory;       ///< Référence à la factory
+    GameConfig config;               ///< Configuration du jeu
+    bool withInversions;             ///< Mode avec renversements?
+    int challengeId;                 ///< ID du challenge actuel
+    GameResult progress{0, 0, 0, 0}; ///< Cumul de la partie (reprise)
+    std::string pendingName;         ///< Nom de l'accord envoyé sans réponse
+    std::vector<std::string> pendingNotes; ///< Ses notes, vide si aucun
 
   public:
     /**
@@ -41,8 +44,8 @@ class ChordGame : public IGameMode {
     void start() override;
 
     /**
-     * @brief Exécute une partie
-     * @return Résultat de la partie
+     * @brief Exécute une partie, ou la poursuit si elle a été interrompue
+     * @return Résultat cumulé de la partie
      */
     GameResult play() override;
 
@@ -0,0 +1,56 @@
+#ifndef CHORDWINDOW_HPP
+#define CHORDWINDOW_HPP
+
+#include <chrono>
+
+/**
+ * @brief Bornes de la fenêtre de regroupement des notes en accord
+ * Bornes égales: fenêtre fixe, sans adaptation au joueur
+ */
+struct ChordWindowPolicy {
+    std::chrono::milliseconds minimum{40};  ///< Joueur rapide (accord plaqué)
+    std::chrono::milliseconds maximum{250}; ///< Débutant (accord arpégé)
+    std::chrono::milliseconds initial{100}; ///< Avant toute mesure
+};
+
+/**
+ * @brief Fenêtre de regroupement d'accord apprise du jeu du joueur
+ * Moyennes mobiles exponentielles des intervalles entre attaques dans un
+ * accord et entre accords: fenêtre = 3 × intervalle dans l'accord, bornée
+ * par la politique et par la moitié de l'intervalle entre accords
+ */
+class ChordWindow {
+  private:
+    ChordWindowPolicy policy;           ///< Bornes de la fenêtre
+    std::chrono::microseconds intra;    ///< Intervalle moyen dans un accord
+    std::chrono::microseconds inter{0}; ///< Entre accords (0 = inconnu)
+    std::chrono::microseconds window;   ///< Fenêtre courante
+
+    /// Poids d'une nouvelle mesure dans les moyennes (1/4)
+    static constexpr int SMOOTHING{4};
+    /// Fenêtre en multiple de l'intervalle moyen dans un accord
+    static constexpr int FACTOR{3};
+
+  public:
+    explicit ChordWindow(ChordWindowPolicy bounds = {});
+
+    /**
+     * @brief Prend en compte l'intervalle entre deux attaques consécutives
+     * Jusqu'au double de la fenêtre, compté dans l'accord: un accord arpégé
+     * coupé en deux par une fenêtre trop courte l'élargit
+     * @param interval Temps écoulé depuis l'attaque précédente
+     */
+    void observe(std::chrono::microseconds interval);
+
+    [[nodiscard]] std::chrono::microseconds current() const {
+        return this->window;
+    }
+    [[nodiscard]] std::chrono::microseconds intraChord() const {
+        return this->intra;
+    }
+    [[nodiscard]] std::chrono::microseconds interChord() const {
+        return this->inter;
+    }
+};
+
+#endif // CHORDWINDOW_HPP
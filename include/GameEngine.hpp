@@ -6,7 +6,24 @@
 #include "IMidiInput.hpp"
 #include "ITransport.hpp"
 #include "Logger.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+/**
+ * @brief Partie interrompue par une déconnexion, en attente de reprise
+ */
+struct SuspendedSession {
+    std::string token;               ///< Jeton remis dans l'`ack`
+    GameConfig config;               ///< Configuration de la partie
+    std::unique_ptr<IGameMode> game; ///< Partie, avec sa progression
+    GameResult progress;             ///< Progression au moment de la coupure
+    std::chrono::steady_clock::time_point expiry; ///< Fin du délai de grâce
+};
 
 /**
  * @brief Moteur de jeu principal
@@ -14,13 +31,26 @@
  */
 class GameEngine {
   private:
-    ITransport& transport;                  ///< Référence au transport
-    IMidiInput& midi;                       ///< Référence à l'entrée MIDI
-    std::unique_ptr<IGameMode> currentGame; ///< Mode de jeu actuel
-    ChallengeFactory factory;               ///< Fabrique de challenges
-    bool running{false};                    ///< État du moteur
+    ITransport& transport;                     ///< Référence au transport
+    IMidiInput& midi;                          ///< Référence à l'entrée MIDI
+    std::unique_ptr<IGameMode> currentGame;    ///< Mode de jeu actuel
+    ChallengeFactory factory;                  ///< Fabrique de challenges
+    std::atomic<bool> running{true};           ///< Faux dès stop() ou drain()
+    std::atomic<bool> draining{false};         ///< Arrêt après la partie?
+    std::string sessionToken;                  ///< Jeton de la session courante
+    std::optional<SuspendedSession> suspended; ///< Partie à reprendre
+    std::chrono::seconds resumeGrace{60};      ///< Délai de reprise (0 = aucun)
+    std::future<bool> midiInit;                ///< Initialisation anticipée
+    std::mutex midiInitMutex;                  ///< Protège midiInit
+    std::mutex gameMutex;                      ///< Protège currentGame, stopped
+    bool stopped{false};                       ///< Vrai dès stop()
 
   private:
+    /**
+     * @brief Attend la fin de l'initialisation MIDI anticipée, s'il y en a une
+     */
+    void awaitMidi();
+
     /**
      * @brief Gère la connexion d'un client
      */
@@ -29,8 +59,29 @@ class GameEngine {
     /**
      * @brief Traite une session de jeu
      * @param config Configuration du jeu
+     * @param resumed Progression de la partie courante si elle est reprise
+     */
+    void processGameSession(const GameConfig& config,
+                            std::optional<GameResult> resumed = std::nullopt);
+
+    /**
+     * @brief Met de côté la partie courante après déconnexion du client
+     * @param config Configuration de la partie
+     * @param progress Progression de la partie
+     */
+    void suspendSession(const GameConfig& config, const GameResult& progress);
+
+    /**
+     * @brief Reprend une partie suspendue, sans nouvelle configuration
+     * @param token Jeton présenté par le client
+     */
+    void resumeSession(const std::string& token);
+
+    /**
+     * @brief Génère un jeton de reprise aléatoire
+     * @return 32 chiffres hexadécimaux
      */
-    void processGameSession(const GameConfig& config);
+    static std::string newToken();
 
     /**
      * @brief Crée un mode de jeu selon la configuration
@@ -51,9 +102,19 @@ class GameEngine {
      * @param ok true si configuration OK, false sinon
      * @param errorCode Code d'erreur éventuel
      * @param errorMessage Message d'erreur éventuel
+     * @param challenges Nombre de challenges de la partie (0 = non annoncé)
      */
     void sendAck(bool ok, const std::string& errorCode = "",
-                 const std::string& errorMessage = "");
+                 const std::string& errorMessage = "", int challenges = 0);
+
+    /**
+     * @brief Signale au client un branchement ou débranchement MIDI
+     * (appelé depuis le thread de surveillance des ports)
+     * @param name Nom du port
+     * @param device Identifiant du port, jamais réutilisé
+     * @param connected true si branché, false si débranché
+     */
+    void sendDevice(const std::string& name, unsigned device, bool connected);
 
   public:
     GameEngine(const GameEngine&) = delete;
@@ -63,23 +124,53 @@ class GameEngine {
 
     GameEngine(ITransport& transport, IMidiInput& midi)
         : transport(transport), midi(midi) {
+        this->midi.onDeviceChange(
+            [this](const std::string& name, unsigned device, bool connected) {
+                sendDevice(name, device, connected);
+            });
         Logger::log("[GameEngine] Instance créée");
     }
 
     ~GameEngine() {
+        this->midi.onDeviceChange(nullptr); // Entrée MIDI détruite après
         stop();
         Logger::log("[GameEngine] Instance détruite");
     }
 
     /**
-     * @brief Lance le moteur de jeu
+     * @brief Définit le délai de reprise d'une partie après déconnexion
+     * @param grace Durée de conservation de la partie (0 pour désactiver)
+     */
+    void setResumeGrace(std::chrono::seconds grace) {
+        this->resumeGrace = grace;
+    }
+
+    /**
+     * @brief Initialise l'entrée MIDI en arrière-plan, pendant le démarrage
+     * du transport et l'attente du client: le premier `config` n'attend plus
+     * l'énumération des ports (nouvel essai s'il a échoué)
+     */
+    void initializeMidiAsync();
+
+    /**
+     * @brief Lance le moteur de jeu, puis ferme l'entrée MIDI à son arrêt
      */
     void run();
 
     /**
-     * @brief Arrête le moteur de jeu
+     * @brief Arrête le moteur de jeu (depuis un autre thread que run())
+     * L'entrée MIDI n'est fermée qu'une fois run() terminé
      */
     void stop();
+
+    /**
+     * @brief Arrête le moteur une fois la partie en cours terminée, en cédant
+     * le client inactif au transport (mise à jour à chaud)
+     */
+    void drain() {
+        this->draining = true;
+        this->running = false;
+    }
 };
 
 #endif // GAMEENGINE_HPP
@@ -0,0 +1,63 @@
+#ifndef HELDKEYS_HPP
+#define HELDKEYS_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Ensemble des touches MIDI enfoncées (0-127), un bit par touche
+ * Mise à jour O(1) à chaque note-on/note-off, sans allocation
+ */
+class HeldKeys {
+  private:
+    std::array<uint64_t, 2> words{}; ///< Touches 0-63 puis 64-127
+
+    static uint64_t bit(uint8_t key) { return uint64_t{1} << (key & 63); }
+
+  public:
+    void press(uint8_t key) { this->words[(key >> 6) & 1] |= bit(key); }
+    void release(uint8_t key) { this->words[(key >> 6) & 1] &= ~bit(key); }
+    void clear() { this->words = {}; }
+
+    [[nodiscard]] bool held(uint8_t key) const {
+        return (this->words[(key >> 6) & 1] & bit(key)) != 0;
+    }
+    [[nodiscard]] size_t count() const {
+        return std::popcount(this->words[0]) + std::popcount(this->words[1]);
+    }
+    [[nodiscard]] bool empty() const {
+        return (this->words[0] | this->words[1]) == 0;
+    }
+    bool operator==(const HeldKeys& other) const = default;
+
+    /**
+     * @brief Retire les touches d'un autre ensemble
+     * @param other Touches à retirer
+     * @return Touches enfoncées absentes de other
+     */
+    [[nodiscard]] HeldKeys without(const HeldKeys& other) const {
+        HeldKeys result;
+        for (size_t w = 0; w < this->words.size(); ++w)
+            result.words[w] = this->words[w] & ~other.words[w];
+        return result;
+    }
+
+    /**
+     * @brief Liste les touches enfoncées
+     * @return Numéros MIDI par ordre croissant
+     */
+    [[nodiscard]] std::vector<uint8_t> keys() const {
+        std::vector<uint8_t> result;
+        result.reserve(count());
+        for (size_t w = 0; w < this->words.size(); ++w)
+            for (uint64_t bits = this->words[w]; bits; bits &= bits - 1)
+                result.push_back(
+                    static_cast<uint8_t>(w * 64 + std::countr_zero(bits)));
+        return result;
+    }
+};
+
+#endif // HELDKEYS_HPP
@@ -44,7 +44,7 @@ class IGameMode {
     virtual GameResult play() = 0;
 
     /**
-     * @brief Arrête le jeu
+     * @brief Arrête le jeu, entrée MIDI suspendue sans être fermée
      */
     virtual void stop() = 0;
 };
@@ -2,6 +2,12 @@
 #define IMIDIINPUT_HPP
 
 #include "Note.hpp"
+#include "NoteEvent.hpp"
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
 #include <vector>
 
 /**
@@ -10,6 +16,11 @@
  */
 class IMidiInput {
   public:
+    /// Appelé au branchement (true) ou débranchement (false) d'un port,
+    /// identifié par NoteEvent::device
+    using DeviceListener = std::function<void(
+        const std::string& name, unsigned device, bool connected)>;
+
     virtual ~IMidiInput() = default;
 
     /**
@@ -24,12 +35,70 @@ class IMidiInput {
      */
     virtual std::vector<Note> readNotes() = 0;
 
+    /**
+     * @brief Lit les attaques de l'accord suivant, en attendant au plus un
+     * délai donné
+     * Jamais d'accord vide: entrée arrêtée signalée par isStopped()
+     * @param timeout Délai d'attente maximum
+     * @return Attaques datées, std::nullopt si délai écoulé ou arrêtée
+     */
+    virtual std::optional<std::vector<NoteEvent>>
+    readEvents(std::chrono::milliseconds timeout) = 0;
+
+    /**
+     * @brief Lit les notes jouées, en attendant au plus un délai donné
+     * @param timeout Délai d'attente maximum
+     * @return Notes jouées, std::nullopt si délai écoulé ou arrêtée
+     */
+    std::optional<std::vector<Note>>
+    readNotes(std::chrono::milliseconds timeout) {
+        auto events = readEvents(timeout);
+        if (!events) return std::nullopt;
+        std::vector<Note> notes;
+        for (const NoteEvent& event : *events) notes.push_back(event.note);
+        return notes;
+    }
+
+    /**
+     * @brief Indique le nombre de notes distinctes attendues: l'accord est
+     * finalisé dès qu'il est atteint, sans attendre la fin du délai
+     * @param count Nombre de notes attendues (0 = délai seul)
+     */
+    virtual void expectNotes(size_t count) { (void)count; }
+
+    /**
+     * @brief Enregistre l'observateur des changements de périphérique,
+     * appelé depuis un thread de surveillance
+     * @param listener Observateur (nullptr pour le retirer)
+     */
+    virtual void onDeviceChange(DeviceListener listener) { (void)listener; }
+
+    /**
+     * @brief Vérifie si la lecture est arrêtée par close() ou pause():
+     * readEvents() ne livre plus aucun accord
+     * @return true si l'entrée est fermée ou suspendue
+     */
+    virtual bool isStopped() const = 0;
+
     /**
      * @brief Vérifie si des notes sont disponibles
      * @return true si des notes sont prêtes à être lues
      */
     virtual bool hasNotes() const = 0;
 
+    /**
+     * @brief Suspend la lecture entre deux parties, périphérique conservé:
+     * readEvents() débloqué (isStopped()) et notes ignorées jusqu'à resume()
+     * Par défaut ferme l'entrée, réinitialisée à la partie suivante
+     */
+    virtual void pause() { close(); }
+
+    /**
+     * @brief Reprend la lecture suspendue par pause(), notes jouées pendant
+     * la pause écartées (depuis le thread qui lit les notes)
+     */
+    virtual void resume() {}
+
     /**
      * @brief Ferme l'entrée MIDI et libère les ressources
      */
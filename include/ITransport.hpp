@@ -2,6 +2,8 @@
 #define ITRANSPORT_HPP
 
 #include "Message.hpp"
+#include <chrono>
+#include <optional>
 
 /**
  * @brief Interface de transport pour la communication client-serveur
@@ -24,6 +26,8 @@ class ITransport {
 
     /**
      * @brief Envoie un message au client connecté
+     * Appelable depuis tout thread, en concurrence avec le thread de jeu
+     * (ex: branchements MIDI signalés par le thread de surveillance)
      * @param msg Message à envoyer
      */
     virtual void send(const Message& msg) = 0;
@@ -34,6 +38,20 @@ class ITransport {
      */
     virtual Message receive() = 0;
 
+    /**
+     * @brief Reçoit un message du client, en attendant au plus `timeout`
+     * @param timeout Durée d'attente maximale
+     * @return Message reçu ("error" si client déconnecté), vide si délai écoulé
+     */
+    virtual std::optional<Message>
+    receive(std::chrono::milliseconds timeout) = 0;
+
+    /**
+     * @brief Reçoit un message du client s'il y en a un, sans attendre
+     * @return Message reçu ("error" si client déconnecté), vide sinon
+     */
+    virtual std::optional<Message> tryReceive() = 0;
+
     /**
      * @brief Vérifie si un message est en attente
      * @return true si un message est disponible
@@ -51,6 +69,13 @@ class ITransport {
      */
     virtual bool isClientConnected() const = 0;
 
+    /**
+     * @brief Cède le client inactif à une nouvelle instance du moteur
+     * (mise à jour à chaud), au lieu de le déconnecter
+     * @return true si cédé, false si non pris en charge par le transport
+     */
+    virtual bool handOffClient() { return false; }
+
     /**
      * @brief Obtient le chemin de la socket Unix
      * @return Chemin de la socket (string)
@@ -0,0 +1,56 @@
+#ifndef LATENCYHISTOGRAM_HPP
+#define LATENCYHISTOGRAM_HPP
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Histogramme de latences à seaux logarithmiques (base 2, en µs)
+ * Enregistrement O(1) sans allocation, percentiles approchés par seau
+ */
+class LatencyHistogram {
+  private:
+    static constexpr size_t BUCKETS{32}; ///< Seau i: [2^i, 2^(i+1)) µs
+    std::array<uint64_t, BUCKETS> buckets{}; ///< Compteurs par seau
+    uint64_t samples{0};                     ///< Nombre de mesures
+    uint64_t totalUs{0};                     ///< Somme des mesures (µs)
+    uint64_t minUs{UINT64_MAX};              ///< Plus petite mesure (µs)
+    uint64_t maxUs{0};                       ///< Plus grande mesure (µs)
+
+  public:
+    /**
+     * @brief Enregistre une mesure de latence
+     * @param latency Durée mesurée
+     */
+    void record(std::chrono::nanoseconds latency);
+
+    /**
+     * @brief Fusionne un autre histogramme dans celui-ci
+     * @param other Histogramme à ajouter
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Estime un percentile (borne supérieure du seau correspondant)
+     * @param p Percentile voulu, entre 0 et 100
+     * @return Latence estimée en microsecondes (0 si aucune mesure)
+     */
+    [[nodiscard]] uint64_t percentileUs(double p) const;
+
+    /**
+     * @brief Résume l'histogramme en une ligne lisible
+     * @return Chaîne "n=… min=… p50=… p90=… p99=… max=…" (µs)
+     */
+    [[nodiscard]] std::string summary() const;
+
+    [[nodiscard]] uint64_t count() const { return this->samples; }
+    [[nodiscard]] uint64_t min() const { return samples ? minUs : 0; }
+    [[nodiscard]] uint64_t max() const { return this->maxUs; }
+    [[nodiscard]] uint64_t mean() const {
+        return samples ? totalUs / samples : 0;
+    }
+};
+
+#endif // LATENCYHISTOGRAM_HPP
@@ -0,0 +1,57 @@
+#ifndef MIDIFILE_HPP
+#define MIDIFILE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Message de canal d'un fichier MIDI, daté depuis le début du morceau
+ */
+struct MidiFileEvent {
+    std::chrono::microseconds time{0}; ///< Selon la carte des tempos
+    uint8_t status{0};                 ///< Type et canal (0x80 à 0xEF)
+    uint8_t data1{0};                  ///< Premier octet (ex: numéro MIDI)
+    uint8_t data2{0};                  ///< Second octet (ex: vélocité), ou 0
+    uint16_t track{0};                 ///< Piste d'origine
+};
+
+/**
+ * @brief Fichier MIDI standard (SMF, formats 0, 1 et 2)
+ * Pistes lues bloc par bloc depuis un flux, statut courant (running status)
+ * et changements de tempo pris en compte, messages de toutes les pistes
+ * fusionnés par ordre chronologique
+ */
+class MidiFile {
+  private:
+    uint16_t format{0};                ///< 0: une piste, 1: simultanées
+    uint16_t tracks{0};                ///< Nombre de pistes (MTrk)
+    std::vector<MidiFileEvent> events; ///< Messages de canal, triés
+
+  public:
+    /**
+     * @brief Lit un fichier MIDI standard depuis un flux binaire
+     * @param in Flux positionné au début de l'en-tête (MThd)
+     * @return Fichier lu
+     * @throws std::runtime_error Fichier tronqué ou mal formé
+     */
+    static MidiFile parse(std::istream& in);
+
+    /**
+     * @brief Lit un fichier MIDI standard depuis le disque
+     * @param path Chemin du fichier (.mid)
+     * @return Fichier lu
+     * @throws std::runtime_error Fichier illisible, tronqué ou mal formé
+     */
+    static MidiFile load(const std::string& path);
+
+    [[nodiscard]] uint16_t getFormat() const { return this->format; }
+    [[nodiscard]] uint16_t getTracks() const { return this->tracks; }
+    [[nodiscard]] const std::vector<MidiFileEvent>& getEvents() const {
+        return this->events;
+    }
+};
+
+#endif // MIDIFILE_HPP
@@ -0,0 +1,161 @@
+#ifndef MIDIFILEINPUT_HPP
+#define MIDIFILEINPUT_HPP
+
+#include "ChordWindow.hpp"
+#include "IMidiInput.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Entrée MIDI rejouant un fichier MIDI standard (.mid)
+ *
+ * Rejoue une performance enregistrée sans clavier, de façon déterministe:
+ * accords regroupés selon les dates du fichier (fenêtre d'accord comme
+ * RtMidiInput en mode Window), livrés au tempo d'origine, accéléré, ou sans
+ * aucune attente
+ */
+class MidiFileInput : public IMidiInput {
+  private:
+    /// Attaque lue dans le fichier
+    struct Onset {
+        std::chrono::microseconds time; ///< Depuis le début du morceau
+        uint8_t midi;                   ///< Numéro MIDI (12-119)
+        uint8_t velocity;               ///< Vélocité (1-127)
+        uint16_t track;                 ///< Piste (NoteEvent::device)
+    };
+
+    /// Accord suivant, calculé sans modifier l'état de lecture
+    struct Chord {
+        size_t end{0};                    ///< Fin de l'accord dans onsets
+        std::chrono::microseconds due{0}; ///< Finalisation (date du fichier)
+        ChordWindow window;               ///< Fenêtre après l'accord
+    };
+
+    std::string path;          ///< Fichier MIDI rejoué
+    double speed{1.0};         ///< Vitesse (0 = sans attente)
+    ChordWindowPolicy policy;  ///< Bornes de la fenêtre d'accord
+    std::vector<Onset> onsets; ///< Attaques, ordre chronologique
+    size_t next{0};            ///< Prochaine attaque à livrer
+    ChordWindow chordWindow;   ///< Fenêtre apprise des attaques
+    std::chrono::steady_clock::time_point start;    ///< Début de la lecture
+    std::chrono::steady_clock::time_point pausedAt; ///< Début de la pause
+    std::atomic<size_t> expectedNotes{0}; ///< Notes attendues (0 = délai)
+    bool ready{false};                    ///< Initialisée et non fermée
+    bool paused{false};                   ///< Lecture suspendue (pause())
+    mutable std::mutex mtx;               ///< Protège l'état de lecture
+    std::condition_variable cv;           ///< Réveille readEvents()
+
+    /**
+     * @brief Regroupe les attaques suivantes en accord
+     * @return Accord suivant, std::nullopt en fin de fichier
+     */
+    std::optional<Chord> nextChord() const;
+
+    /**
+     * @brief Convertit une date du fichier en instant de lecture
+     * @param time Date depuis le début du morceau
+     * @return Instant correspondant selon la vitesse
+     */
+    std::chrono::steady_clock::time_point at(
+        std::chrono::microseconds time) const;
+
+  public:
+    MidiFileInput(const MidiFileInput&) = delete;
+    MidiFileInput& operator=(const MidiFileInput&) = delete;
+    MidiFileInput(MidiFileInput&&) = delete;
+    MidiFileInput& operator=(MidiFileInput&&) = delete;
+
+    /**
+     * @brief Crée l'entrée, fichier lu à l'initialisation
+     * @param filePath Chemin du fichier MIDI
+     * @param playbackSpeed Vitesse (1 = tempo d'origine, 0 = sans attente)
+     */
+    explicit MidiFileInput(std::string filePath, double playbackSpeed = 1.0);
+
+    ~MidiFileInput() override { close(); }
+
+    /**
+     * @brief Lit le fichier MIDI et démarre la lecture
+     * @return true si le fichier est lisible et bien formé
+     */
+    bool initialize() override;
+
+    /**
+     * @brief Lit les notes de l'accord suivant (bloquant)
+     * @return Vecteur de notes jouées (vide si arrêtée)
+     */
+    std::vector<Note> readNotes() override;
+
+    using IMidiInput::readNotes;
+
+    /**
+     * @brief Lit les attaques de l'accord suivant, à sa date de finalisation
+     * En fin de fichier, plus aucun accord: délai toujours écoulé
+     * @param timeout Délai d'attente maximum
+     * @return Attaques datées, std::nullopt si délai écoulé ou arrêtée
+     */
+    std::optional<std::vector<NoteEvent>>
+    readEvents(std::chrono::milliseconds timeout) override;
+
+    /**
+     * @brief Finalise l'accord dès le nombre de notes distinctes atteint
+     * @param count Nombre de notes attendues (0 = délai seul)
+     */
+    void expectNotes(size_t count) override;
+
+    /**
+     * @brief Vérifie si l'accord suivant est déjà finalisé
+     * @return true si readEvents() le livrerait sans attendre
+     */
+    bool hasNotes() const override;
+
+    /**
+     * @brief Suspend la lecture et débloque readEvents(), position conservée
+     */
+    void pause() override;
+
+    /**
+     * @brief Reprend la lecture à la position atteinte lors de pause()
+     */
+    void resume() override;
+
+    /**
+     * @brief Arrête la lecture et débloque readEvents()
+     */
+    void close() override;
+
+    bool isReady() const override {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        return this->ready;
+    }
+
+    bool isStopped() const override {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        return !this->ready || this->paused;
+    }
+
+    /**
+     * @brief Configure les bornes de la fenêtre d'accord (avant initialize())
+     * @param chordPolicy Bornes, égales pour une fenêtre fixe
+     */
+    void setChordWindow(const ChordWindowPolicy& chordPolicy) {
+        this->policy = chordPolicy;
+    }
+
+    /**
+     * @brief Compte les attaques restant à livrer
+     * @return Nombre d'attaques du fichier pas encore lues
+     */
+    [[nodiscard]] size_t remaining() const {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        return this->onsets.size() - this->next;
+    }
+};
+
+#endif // MIDIFILEINPUT_HPP
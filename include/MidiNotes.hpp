@@ -0,0 +1,85 @@
+#ifndef MIDINOTES_HPP
+#define MIDINOTES_HPP
+
+#include "Note.hpp"
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Nom d'un numéro MIDI, calculé à la compilation (ex: "c#4")
+ */
+struct MidiNoteName {
+    char text[5]{};      ///< Nom et octave, sans zéro final
+    uint8_t size{0};     ///< Longueur de text
+    uint8_t nameSize{0}; ///< Longueur du nom seul (1 ou 2)
+    int8_t octave{0};    ///< Octave, de -1 à 9
+
+    [[nodiscard]] constexpr std::string_view str() const {
+        return {this->text, this->size};
+    }
+    [[nodiscard]] constexpr std::string_view name() const {
+        return {this->text, this->nameSize};
+    }
+    /// Représentable par Note (octaves 0 à 8)?
+    [[nodiscard]] constexpr bool playable() const {
+        return this->octave >= 0 && this->octave <= 8;
+    }
+};
+
+/**
+ * @brief Construit la table des 128 numéros MIDI (c4 = 60, dièses)
+ * @return Noms indexés par numéro MIDI
+ */
+constexpr std::array<MidiNoteName, 128> makeMidiNoteNames() {
+    constexpr std::string_view NAMES[] = {"c",  "c#", "d",  "d#", "e",  "f",
+                                          "f#", "g",  "g#", "a",  "a#", "b"};
+    std::array<MidiNoteName, 128> table{};
+    for (int midi = 0; midi < 128; ++midi) {
+        MidiNoteName& entry = table[midi];
+        std::string_view name = NAMES[midi % 12];
+        entry.octave = static_cast<int8_t>(midi / 12 - 1);
+        for (char c : name) entry.text[entry.size++] = c;
+        entry.nameSize = entry.size;
+        if (entry.octave < 0) entry.text[entry.size++] = '-';
+        entry.text[entry.size++] =
+            static_cast<char>('0' + (entry.octave < 0 ? 1 : entry.octave));
+    }
+    return table;
+}
+
+/// Noms des notes MIDI, sans calcul ni allocation à l'exécution
+inline constexpr std::array<MidiNoteName, 128> MIDI_NOTE_NAMES =
+    makeMidiNoteNames();
+
+static_assert(MIDI_NOTE_NAMES[60].str() == "c4");
+static_assert(MIDI_NOTE_NAMES[61].str() == "c#4");
+static_assert(MIDI_NOTE_NAMES[0].str() == "c-1");
+static_assert(MIDI_NOTE_NAMES[127].str() == "g9");
+
+/**
+ * @brief Convertit un numéro MIDI en Note par simple indexation
+ * Notes construites une seule fois, au premier appel
+ * @param midi Numéro MIDI (0-127)
+ * @return Note correspondante
+ * @throws std::invalid_argument Hors des octaves 0 à 8 (numéros 12 à 119)
+ */
+inline const Note& midiToNote(uint8_t midi) {
+    static const std::array<Note, 128> NOTES = [] {
+        std::array<Note, 128> notes;
+        for (size_t i = 0; i < notes.size(); ++i)
+            if (MIDI_NOTE_NAMES[i].playable())
+                notes[i] = Note(std::string(MIDI_NOTE_NAMES[i].name()),
+                                MIDI_NOTE_NAMES[i].octave);
+        return notes;
+    }();
+    const MidiNoteName& entry = MIDI_NOTE_NAMES[midi & 0x7F];
+    if (!entry.playable())
+        throw std::invalid_argument("MIDI note out of range: " +
+                                    std::string(entry.str()));
+    return NOTES[midi & 0x7F];
+}
+
+#endif // MIDINOTES_HPP
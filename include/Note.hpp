@@ -87,6 +87,17 @@ class Note {
      */
     int getOctave() const { return this->octave; }
 
+    /**
+     * @brief Convertit la note en numéro MIDI (c4 = 60)
+     * @return Numéro MIDI de la note
+     */
+    int toMidi() const {
+        static constexpr int SEMITONES[] = {9, 11, 0, 2, 4, 5, 7}; // a à g
+        int semitone = SEMITONES[this->name[0] - 'a'];
+        if (this->name.size() > 1) semitone += this->name[1] == '#' ? 1 : -1;
+        return (this->octave + 1) * 12 + semitone;
+    }
+
     /**
      * @brief Compare deux notes pour l'égalité
      * @param other Autre note
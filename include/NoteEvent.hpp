@@ -0,0 +1,19 @@
+#ifndef NOTEEVENT_HPP
+#define NOTEEVENT_HPP
+
+#include "Note.hpp"
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Attaque d'une touche, datée au plus près du périphérique MIDI
+ */
+struct NoteEvent {
+    uint8_t midi{0};     ///< Numéro MIDI (0-127)
+    uint8_t velocity{0}; ///< Vélocité de l'attaque (1-127)
+    unsigned device{0};  ///< Port MIDI d'origine (jamais réutilisé)
+    Note note;           ///< Note correspondant au numéro MIDI
+    std::chrono::steady_clock::time_point time; ///< Instant de l'attaque
+};
+
+#endif // NOTEEVENT_HPP
@@ -16,11 +16,13 @@
  */
 class NoteGame : public IGameMode {
   private:
-    ITransport& transport;     ///< Référence au transport
-    IMidiInput& midi;          ///< Référence à l'entrée MIDI
-    ChallengeFactory& factory; ///< Référence à la factory
-    GameConfig config;         ///< Configuration du jeu
-    int challengeId;           ///< ID du challenge actuel
+    ITransport& transport;           ///< Référence au transport
+    IMidiInput& midi;                ///< Référence à l'entrée MIDI
+    ChallengeFactory& factory;       ///< Référence à la factory
+    GameConfig config;               ///< Configuration du jeu
+    int challengeId;                 ///< ID du challenge actuel
+    GameResult progress{0, 0, 0, 0}; ///< Cumul de la partie (reprise)
+    std::string pendingNote;         ///< Note envoyée sans réponse, ou vide
 
   public:
     /**
@@ -39,8 +41,8 @@ class NoteGame : public IGameMode {
     void start() override;
 
     /**
-     * @brief Exécute une partie
-     * @return Résultat de la partie
+     * @brief Exécute une partie, ou la poursuit si elle a été interrompue
+     * @return Résultat cumulé de la partie
      */
     GameResult play() override;
 
@@ -0,0 +1,24 @@
+#ifndef REALTIMEPOLICY_HPP
+#define REALTIMEPOLICY_HPP
+
+#include <string>
+
+/**
+ * @brief Ordonnancement d'un thread sensible à la gigue (minuteur d'accord)
+ */
+struct RealtimePolicy {
+    int priority{0};        ///< Priorité temps réel (0 = ordonnancement normal)
+    bool roundRobin{false}; ///< SCHED_RR au lieu de SCHED_FIFO
+    int cpu{-1};            ///< Cœur dédié (-1 = aucun)
+};
+
+/**
+ * @brief Applique la politique au thread appelant, ordonnancement normal
+ * conservé si refusé (droits manquants, cœur inexistant, plateforme)
+ * @param policy Priorité et cœur demandés
+ * @param name Nom du thread pour le journal
+ * @return true si toute la politique a été appliquée
+ */
+bool applyRealtimePolicy(const RealtimePolicy& policy, const std::string& name);
+
+#endif // REALTIMEPOLICY_HPP
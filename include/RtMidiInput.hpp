@@ -1,11 +1,22 @@
 #ifndef RTMIDIINPUT_HPP
 #define RTMIDIINPUT_HPP
 
+#include "ChordWindow.hpp"
+#include "HeldKeys.hpp"
 #include "IMidiInput.hpp"
+#include "LatencyHistogram.hpp"
 #include "Logger.hpp"
+#include "RealtimePolicy.hpp"
+#include "SpscQueue.hpp"
+#include "Waker.hpp"
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -16,6 +27,9 @@
 // Interfaces for wrapping RtMidi
 class IRtMidiIn {
   public:
+    /// Appelé depuis le thread RtMidi pour chaque message (delta en s)
+    using Callback = std::function<void(double, std::vector<unsigned char>*)>;
+
     virtual ~IRtMidiIn() = default;
     virtual void
     openPort(unsigned int portNumber = 0,
@@ -23,6 +37,8 @@ class IRtMidiIn {
     virtual void openVirtualPort(const std::string& portName) = 0;
     virtual void ignoreTypes(bool midiSysex, bool midiTime, bool midiSense) = 0;
     virtual double getMessage(std::vector<unsigned char>* message) = 0;
+    virtual void setCallback(Callback callback) = 0;
+    virtual void cancelCallback() = 0;
     virtual unsigned int getPortCount() = 0;
     virtual std::string getPortName(unsigned int portNumber) = 0;
 };
@@ -38,6 +54,44 @@ class IRtMidiOut {
     virtual std::string getPortName(unsigned int portNumber) = 0;
 };
 
+/**
+ * @brief Routage MIDI entre ports d'autres clients (séquenceur ALSA)
+ */
+class IMidiRouter {
+  public:
+    virtual ~IMidiRouter() = default;
+
+    /**
+     * @brief Abonne un port de destination aux messages d'un port source
+     * L'abonnement survit au routeur, comme celui créé par `aconnect`
+     * @param source Adresse du port source ("client:port" ou nom du client)
+     * @param destination Adresse du port de destination
+     * @return true si connectés (ou déjà connectés)
+     */
+    virtual bool connect(const std::string& source,
+                         const std::string& destination) = 0;
+};
+
+/**
+ * @brief Critère de fin d'un accord
+ */
+enum class ChordMode {
+    Window,  ///< Aucune nouvelle note pendant la fenêtre (ChordWindow)
+    Release, ///< Toutes les touches relâchées
+    Stable,  ///< Touches tenues inchangées un délai donné, ou relâchées
+};
+
+/**
+ * @brief Statistiques de l'entrée MIDI depuis son initialisation
+ */
+struct MidiInputStats {
+    uint64_t chords{0};  ///< Accords finalisés
+    uint64_t dropped{0}; ///< Notes ou accords perdus (files pleines)
+    std::chrono::microseconds chordWindow{0}; ///< Fenêtre d'accord actuelle
+    std::chrono::microseconds intraChord{0};  ///< Intervalle moyen d'attaque
+    std::chrono::microseconds timerLate{0};   ///< Retard p99 du minuteur
+};
+
 /**
  * @brief Implémentation de l'entrée MIDI via RTMidi
  *
@@ -45,29 +99,139 @@ class IRtMidiOut {
  */
 class RtMidiInput : public IMidiInput {
   private:
-    std::unique_ptr<IRtMidiIn> midiIn{nullptr};   ///< Instance RTMidi (Wrapper)
+    /// Touche enfoncée ou relâchée, datée à sa réception par le thread RtMidi
+    struct KeyEvent {
+        uint8_t key;                                ///< Numéro MIDI (0-127)
+        uint8_t velocity;                           ///< 0 si relâchée
+        unsigned device;                            ///< Port MIDI d'origine
+        std::chrono::steady_clock::time_point time; ///< Horloge périphérique
+    };
+
+  protected:
+    /// Port MIDI ouvert, lu par son propre thread RtMidi (seul producteur)
+    struct MidiPort {
+        std::string name;               ///< Nom du port ("" si virtuel)
+        unsigned device{0};             ///< Identifiant (NoteEvent::device)
+        SpscQueue<KeyEvent, 256> queue; ///< Touches (RtMidi → minuteur)
+        std::chrono::steady_clock::time_point time; ///< Dernier message reçu
+        /// Instance RTMidi, détruite en premier: plus aucun appel ensuite
+        std::unique_ptr<IRtMidiIn> in;
+    };
+
+  private:
+    /// Ports ouverts, modifiés par la surveillance des branchements
+    std::vector<std::unique_ptr<MidiPort>> ports;
+    mutable std::mutex portsMutex; ///< Protège ports (ajout ou retrait)
     std::unique_ptr<IRtMidiOut> midiOut{nullptr}; ///< Sortie MIDI (Wrapper)
-    std::vector<Note> lastNotes;                  ///< Dernières notes jouées
-    std::atomic<bool> notesAvailable{false};      ///< Notes disponibles?
-    std::mutex notesMutex; ///< Mutex pour accès aux notes
+    size_t maxPorts{1};     ///< Ports matériels ouverts au plus (0 = tous)
+    unsigned nextDevice{0}; ///< Identifiant du prochain port matériel ouvert
+    std::atomic<uint64_t> retiredDrops{0}; ///< Pertes des ports débranchés
+
+    std::unique_ptr<IRtMidiIn> scanner; ///< Énumère les ports (surveillance)
+    std::chrono::milliseconds hotplugInterval{0}; ///< Période (0 = aucune)
+    std::thread watchThread;                      ///< Surveillance des ports
+    Waker watchWake;                              ///< Réveille la surveillance
+    DeviceListener deviceListener; ///< Observateur des branchements
+    std::mutex listenerMutex;      ///< Protège deviceListener
+
+    Waker noteWake;               ///< Réveille le minuteur d'accord
+    std::vector<KeyEvent> merged; ///< Touches de tous les ports (minuteur)
+    SpscQueue<std::vector<NoteEvent>, 64> chordQueue; ///< Minuteur → jeu
+    Waker chordWake;                                  ///< Réveille readEvents()
+    std::vector<NoteEvent> currentNotes; ///< Accord en cours (minuteur seul)
+    std::array<NoteEvent, 128> pressed;  ///< Dernière attaque de chaque touche
+    std::chrono::steady_clock::time_point chordDeadline; ///< Fin de l'accord
+    std::chrono::steady_clock::time_point lastOnset;     ///< Attaque précédente
+    ChordWindow chordWindow; ///< Délai sans nouvelle note clôturant l'accord
+    ChordMode chordMode{ChordMode::Window};  ///< Critère de fin d'accord
+    std::chrono::milliseconds stableFor{30}; ///< Délai du mode Stable
+    HeldKeys heldKeys;  ///< Touches enfoncées (minuteur seul)
+    HeldKeys chordKeys; ///< Plus grand ensemble tenu de l'accord en cours
+    HeldKeys staleKeys; ///< Encore tenues depuis l'accord précédent
+    std::atomic<size_t> expectedNotes{0}; ///< Notes attendues (0 = délai seul)
+
+    std::atomic<uint64_t> chords{0}; ///< Accords finalisés (statistiques)
+    std::atomic<std::chrono::microseconds> window{}; ///< Fenêtre publiée
+    std::atomic<std::chrono::microseconds> intra{};  ///< Intervalle publié
+    LatencyHistogram lateness; ///< Retard des réveils à échéance (minuteur)
+    std::atomic<std::chrono::microseconds> late{}; ///< Retard p99 publié
+    RealtimePolicy realtime; ///< Ordonnancement du minuteur d'accord
 
     std::atomic<bool> shouldStop{false}; ///< Flag d'arrêt du thread
-    std::thread inputThread;             ///< Thread de traitement
+    std::atomic<bool> paused{false};     ///< Accords écartés (pause())
+    std::thread chordThread;             ///< Minuteur de fin d'accord
+
+    /// Écart toléré entre horloge du périphérique et horloge locale
+    static constexpr std::chrono::milliseconds MAX_SKEW{50};
 
   private:
     /**
-     * @brief Traite les messages MIDI reçus (thread séparé)
+     * @brief Ajoute un port d'entrée et le lit dès ses messages reçus
+     * Port matériel identifié par un nouvel identifiant, même rebranché
+     * @param in Instance RTMidi, port déjà ouvert
+     * @param name Nom du port matériel ("" pour le port virtuel)
+     */
+    void addPort(std::unique_ptr<IRtMidiIn> in, const std::string& name);
+
+    /**
+     * @brief Reçoit les messages d'un port dès leur arrivée (thread RtMidi)
+     * @param port Port à écouter
+     */
+    void listen(MidiPort& port);
+
+    /**
+     * @brief Vérifie si un port est un clavier ou contrôleur à ouvrir
+     * @param name Nom du port
+     * @return false pour nos propres ports, "Midi Through" et FluidSynth
+     */
+    static bool isHardwarePort(const std::string& name);
+
+    /**
+     * @brief Surveille branchements et débranchements (thread séparé)
      */
-    void processMidiMessages();
+    void watchPorts();
 
     /**
-     * @brief Convertit un numéro MIDI en Note
-     * @param midiNote Numéro MIDI (0-127)
-     * @return Note correspondante
+     * @brief Ouvre les ports apparus et ferme les ports disparus
+     * Port virtuel ouvert tant qu'aucun port matériel n'est disponible
      */
-    Note convertMidiToNote(int midiNote) const;
+    void rescanPorts();
+
+    /**
+     * @brief Signale un changement de périphérique à l'observateur
+     * @param port Port branché ou débranché
+     * @param connected true si branché, false si débranché
+     */
+    void notifyDevice(const MidiPort& port, bool connected);
+
+    /**
+     * @brief Finalise chaque accord à son échéance (thread séparé)
+     */
+    void finalizeChords();
+
+    /**
+     * @brief Met à jour touches tenues et accord en cours (minuteur seul)
+     * @param event Touche enfoncée ou relâchée
+     */
+    void onKey(const KeyEvent& event);
+
+    /**
+     * @brief Vérifie si l'accord en cours est terminé selon chordMode
+     * @return true si l'accord doit être finalisé maintenant
+     */
+    bool chordReady() const;
+
+    /**
+     * @brief Vérifie si l'accord en cours atteint le nombre de notes attendu
+     * @return true si l'accord peut être finalisé avant son échéance
+     */
+    bool chordComplete() const;
 
   public:
+    /// Identifiant du port virtuel (NoteEvent::device), distinct de tout
+    /// port matériel, même ouvert en même temps pendant un rebranchement
+    static constexpr unsigned VIRTUAL_DEVICE{~0u};
+
     RtMidiInput(const RtMidiInput&) = delete;
     RtMidiInput& operator=(const RtMidiInput&) = delete;
     RtMidiInput(RtMidiInput&&) = delete;
@@ -92,6 +256,25 @@ class RtMidiInput : public IMidiInput {
      */
     std::vector<Note> readNotes() override;
 
+    using IMidiInput::readNotes;
+
+    /**
+     * @brief Lit les attaques d'un accord, réveillé dès sa finalisation
+     * @param timeout Délai d'attente maximum
+     * @return Attaques datées, std::nullopt si délai écoulé ou arrêtée
+     */
+    std::optional<std::vector<NoteEvent>>
+    readEvents(std::chrono::milliseconds timeout) override;
+
+    /**
+     * @brief Finalise l'accord dès le nombre de notes distinctes atteint
+     * @param count Nombre de notes attendues (0 = délai seul)
+     */
+    void expectNotes(size_t count) override {
+        this->expectedNotes = count;
+        this->noteWake.notify(); // Accord en cours peut-être déjà complet
+    }
+
     /**
      * @brief Vérifie si des notes sont disponibles
      * @return true si des notes sont prêtes à être lues
@@ -103,13 +286,121 @@ class RtMidiInput : public IMidiInput {
      */
     void close() override;
 
+    /**
+     * @brief Suspend la lecture, ports et threads conservés: accords
+     * finalisés écartés jusqu'à resume()
+     */
+    void pause() override;
+
+    /**
+     * @brief Reprend la lecture, accords en attente écartés
+     */
+    void resume() override;
+
+    /**
+     * @brief Compte les notes et accords perdus faute de place dans les files
+     * @return Nombre d'éléments perdus depuis la création
+     */
+    [[nodiscard]] uint64_t droppedCount() const {
+        uint64_t dropped =
+            this->chordQueue.overflowCount() + this->retiredDrops;
+        std::lock_guard<std::mutex> lock(this->portsMutex);
+        for (const auto& port : this->ports)
+            dropped += port->queue.overflowCount();
+        return dropped;
+    }
+
+    /**
+     * @brief Limite le nombre de ports matériels ouverts (avant initialize())
+     * Plusieurs claviers ou contrôleurs alimentent alors un seul flux
+     * @param count Nombre de ports au plus (0 = tous les ports détectés)
+     */
+    void setMaxPorts(size_t count) { this->maxPorts = count; }
+
+    /**
+     * @brief Donne au minuteur d'accord une priorité temps réel et un cœur
+     * (avant initialize()), ordonnancement normal si refusé
+     * @param policy Priorité SCHED_FIFO/SCHED_RR et cœur dédié
+     */
+    void setRealtime(const RealtimePolicy& policy) { this->realtime = policy; }
+
+    /**
+     * @brief Obtient le nombre de ports d'entrée ouverts
+     * @return Ports matériels ouverts, ou 1 pour le port virtuel
+     */
+    [[nodiscard]] size_t portCount() const {
+        std::lock_guard<std::mutex> lock(this->portsMutex);
+        return this->ports.size();
+    }
+
+    /**
+     * @brief Active la surveillance des branchements (avant initialize())
+     * Un clavier branché après le démarrage, ou rebranché, est ouvert sans
+     * interrompre la partie en cours
+     * @param interval Période d'énumération des ports (0 = désactivée)
+     */
+    void setHotplug(std::chrono::milliseconds interval) {
+        this->hotplugInterval = interval;
+    }
+
+    /**
+     * @brief Enregistre l'observateur des branchements de ports matériels
+     * @param listener Observateur (nullptr pour le retirer)
+     */
+    void onDeviceChange(DeviceListener listener) override {
+        std::lock_guard<std::mutex> lock(this->listenerMutex);
+        this->deviceListener = std::move(listener);
+    }
+
+    /**
+     * @brief Configure les bornes de la fenêtre d'accord (avant initialize())
+     * @param policy Bornes, égales pour une fenêtre fixe
+     */
+    void setChordWindow(const ChordWindowPolicy& policy) {
+        this->chordWindow = ChordWindow(policy);
+    }
+
+    /**
+     * @brief Choisit le critère de fin d'accord (avant initialize())
+     * @param mode Fenêtre de temps, relâchement ou stabilité des touches
+     * @param stable Durée sans changement des touches tenues (mode Stable)
+     */
+    void setChordMode(ChordMode mode, std::chrono::milliseconds stable =
+                                          std::chrono::milliseconds(30)) {
+        this->chordMode = mode;
+        this->stableFor = stable;
+    }
+
+    /**
+     * @brief Obtient les statistiques de l'entrée MIDI
+     * @return Accords, pertes, fenêtre d'accord et gigue du minuteur
+     */
+    MidiInputStats getStats() const;
+
     /**
      * @brief Vérifie si MIDI est prêt
      * @return true si MIDI est prêt
      */
     bool isReady() const override;
 
+    /**
+     * @brief Vérifie si la lecture est arrêtée par close() ou pause()
+     * @return true si readEvents() ne livre plus d'accord
+     */
+    bool isStopped() const override {
+        return this->shouldStop || this->paused;
+    }
+
   protected:
+    /**
+     * @brief Traite un message MIDI dès sa réception (thread RtMidi du port)
+     * @param port Port ayant reçu le message
+     * @param deltaTime Secondes depuis le message précédent (périphérique)
+     * @param message Octets du message
+     */
+    virtual void onMidiMessage(MidiPort& port, double deltaTime,
+                               const std::vector<unsigned char>& message);
+
     /**
      * @brief Crée l'instance IRtMidiIn
      * @return Pointeur unique vers IRtMidiIn
@@ -121,6 +412,12 @@ class RtMidiInput : public IMidiInput {
      * @return Pointeur unique vers IRtMidiOut
      */
     virtual std::unique_ptr<IRtMidiOut> createMidiOut();
+
+    /**
+     * @brief Crée le routeur vers le synthétiseur
+     * @return Pointeur unique vers IMidiRouter
+     */
+    virtual std::unique_ptr<IMidiRouter> createMidiRouter();
 };
 
 #endif // RTMIDIINPUT_HPP
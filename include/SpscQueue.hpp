@@ -0,0 +1,75 @@
+#ifndef SPSCQUEUE_HPP
+#define SPSCQUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+/**
+ * @brief File circulaire bornée, un seul producteur et un seul consommateur
+ * Sans verrou ni allocation: ni l'un ni l'autre ne bloque jamais, un ajout
+ * dans une file pleine est refusé et compté
+ * @tparam T Type des éléments (constructible par défaut)
+ * @tparam Capacity Nombre d'emplacements (puissance de 2)
+ */
+template <typename T, size_t Capacity> class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity doit être une puissance de 2");
+
+  private:
+    static constexpr size_t MASK{Capacity - 1}; ///< Index → emplacement
+    std::array<T, Capacity> slots{};            ///< Éléments en attente
+
+    /// Prochain emplacement lu (écrit par le consommateur seul)
+    alignas(64) std::atomic<size_t> head{0};
+    /// Prochain emplacement écrit (écrit par le producteur seul)
+    alignas(64) std::atomic<size_t> tail{0};
+    /// Ajouts refusés file pleine (écrit par le producteur seul)
+    alignas(64) std::atomic<uint64_t> overflows{0};
+
+  public:
+    /**
+     * @brief Ajoute un élément (producteur seul)
+     * @param value Élément à ajouter
+     * @return false si la file est pleine (élément compté comme perdu)
+     */
+    bool tryPush(T value) {
+        size_t t = this->tail.load(std::memory_order_relaxed);
+        if (t - this->head.load(std::memory_order_acquire) == Capacity) {
+            this->overflows.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        this->slots[t & MASK] = std::move(value);
+        this->tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Retire l'élément le plus ancien (consommateur seul)
+     * @return Élément retiré, std::nullopt si la file est vide
+     */
+    std::optional<T> tryPop() {
+        size_t h = this->head.load(std::memory_order_relaxed);
+        if (h == this->tail.load(std::memory_order_acquire))
+            return std::nullopt;
+        std::optional<T> value{std::move(this->slots[h & MASK])};
+        this->head.store(h + 1, std::memory_order_release);
+        return value;
+    }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+    [[nodiscard]] size_t size() const {
+        // head lu en premier: tail ne peut alors que lui être supérieur
+        size_t h = this->head.load(std::memory_order_acquire);
+        return this->tail.load(std::memory_order_acquire) - h;
+    }
+    [[nodiscard]] static constexpr size_t capacity() { return Capacity; }
+    [[nodiscard]] uint64_t overflowCount() const {
+        return this->overflows.load(std::memory_order_relaxed);
+    }
+};
+
+#endif // SPSCQUEUE_HPP
@@ -0,0 +1,141 @@
+#ifndef SYNTHETICMIDIINPUT_HPP
+#define SYNTHETICMIDIINPUT_HPP
+
+#include "IMidiInput.hpp"
+#include "Message.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Modèle du joueur simulé (temps de réaction et erreurs)
+ */
+struct PerformerModel {
+    std::chrono::milliseconds reaction{600}; ///< Temps de réaction médian
+    double reactionSpread{0.3};   ///< Dispersion (écart type log-normal)
+    double errorRate{0.1};        ///< Probabilité d'une note fausse (± 1-2)
+    double wrongOctaveRate{0.05}; ///< Probabilité d'une octave fausse
+    std::chrono::milliseconds rollSpread{30}; ///< Étalement d'un accord
+    uint32_t seed{0};                         ///< Graine (0 = aléatoire)
+};
+
+/**
+ * @brief Entrée MIDI simulée: un joueur répond à chaque challenge envoyé
+ *
+ * Les challenges `note` et `chord` lui sont présentés par onChallenge(),
+ * branché sur les messages sortants du moteur (TappedTransport). Réponses
+ * datées selon le modèle, livrées en temps réel (vitesse 1), accéléré, ou
+ * sans attente (vitesse 0) pour éprouver le moteur à plein régime
+ */
+class SyntheticMidiInput : public IMidiInput {
+  private:
+    PerformerModel model; ///< Comportement du joueur
+    double speed{1.0};    ///< Vitesse (0 = sans attente)
+    std::mt19937 random;  ///< Tirages du modèle
+    std::optional<std::vector<NoteEvent>> answer; ///< Réponse en attente
+    std::chrono::steady_clock::time_point due;    ///< Livraison de answer
+    uint64_t challenges{0};                       ///< Challenges reçus
+    uint64_t mistakes{0};       ///< Notes fausses ou à la mauvaise octave
+    bool ready{false};          ///< Initialisée et non fermée
+    bool paused{false};         ///< Challenges ignorés (pause())
+    mutable std::mutex mtx;     ///< Protège réponse et tirages
+    std::condition_variable cv; ///< Réveille readEvents()
+
+    /**
+     * @brief Tire la réponse du joueur à un challenge
+     * @param expected Notes attendues
+     * @param shown Instant où le challenge est présenté
+     */
+    void perform(const std::vector<Note>& expected,
+                 std::chrono::steady_clock::time_point shown);
+
+    /**
+     * @brief Tire la note effectivement jouée pour une note attendue
+     * @param expected Note attendue
+     * @return Numéro MIDI joué, Note attendue si aucune erreur
+     */
+    std::pair<uint8_t, Note> play(const Note& expected);
+
+  public:
+    /**
+     * @brief Crée le joueur simulé
+     * @param performer Modèle du joueur
+     * @param playbackSpeed Vitesse (1 = temps réel, 0 = sans attente)
+     */
+    explicit SyntheticMidiInput(PerformerModel performer = {},
+                                double playbackSpeed = 1.0);
+
+    ~SyntheticMidiInput() override { close(); }
+
+    /**
+     * @brief Présente un message envoyé par le moteur au joueur
+     * Seuls les challenges `note` et `chord` appellent une réponse
+     * Appelable depuis tout thread qui envoie (TappedTransport)
+     * @param msg Message sortant du moteur
+     */
+    void onChallenge(const Message& msg);
+
+    bool initialize() override;
+
+    /**
+     * @brief Lit la réponse au challenge en cours (bloquant)
+     * @return Notes jouées (vide si arrêtée)
+     */
+    std::vector<Note> readNotes() override;
+
+    using IMidiInput::readNotes;
+
+    /**
+     * @brief Lit la réponse au challenge en cours, une fois jouée
+     * @param timeout Délai d'attente maximum
+     * @return Attaques datées, std::nullopt si délai écoulé ou arrêtée
+     */
+    std::optional<std::vector<NoteEvent>>
+    readEvents(std::chrono::milliseconds timeout) override;
+
+    bool hasNotes() const override;
+
+    /**
+     * @brief Abandonne la réponse en attente et ignore les challenges
+     */
+    void pause() override;
+
+    void resume() override;
+
+    void close() override;
+
+    bool isReady() const override {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        return this->ready;
+    }
+
+    bool isStopped() const override {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        return !this->ready || this->paused;
+    }
+
+    /**
+     * @brief Compte les challenges auxquels le joueur a répondu
+     * @return Nombre de challenges reçus
+     */
+    [[nodiscard]] uint64_t challengeCount() const {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        return this->challenges;
+    }
+
+    /**
+     * @brief Compte les notes jouées fausses selon le modèle
+     * @return Notes fausses ou à la mauvaise octave
+     */
+    [[nodiscard]] uint64_t mistakeCount() const {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        return this->mistakes;
+    }
+};
+
+#endif // SYNTHETICMIDIINPUT_HPP
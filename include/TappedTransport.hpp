@@ -0,0 +1,57 @@
+#ifndef TAPPEDTRANSPORT_HPP
+#define TAPPEDTRANSPORT_HPP
+
+#include "ITransport.hpp"
+#include <functional>
+#include <utility>
+
+/**
+ * @brief Transport relayant tout à un autre, en présentant chaque message
+ * envoyé au client à un observateur (ex: SyntheticMidiInput)
+ */
+class TappedTransport : public ITransport {
+  public:
+    /// Appelé avant chaque envoi, depuis le thread qui envoie: comme send(),
+    /// doit accepter des appels concurrents de plusieurs threads
+    using Tap = std::function<void(const Message&)>;
+
+  private:
+    ITransport& inner; ///< Transport réel ou doublure
+    Tap tap;           ///< Observateur des messages envoyés
+
+  public:
+    TappedTransport(ITransport& transport, Tap observer)
+        : inner(transport), tap(std::move(observer)) {}
+
+    bool start() override { return this->inner.start(); }
+    void waitForClient() override { this->inner.waitForClient(); }
+
+    /**
+     * @brief Présente le message à l'observateur, puis l'envoie
+     * @param msg Message à envoyer
+     */
+    void send(const Message& msg) override {
+        if (this->tap) this->tap(msg);
+        this->inner.send(msg);
+    }
+
+    Message receive() override { return this->inner.receive(); }
+    std::optional<Message>
+    receive(std::chrono::milliseconds timeout) override {
+        return this->inner.receive(timeout);
+    }
+    std::optional<Message> tryReceive() override {
+        return this->inner.tryReceive();
+    }
+    bool hasMessage() const override { return this->inner.hasMessage(); }
+    void stop() override { this->inner.stop(); }
+    bool isClientConnected() const override {
+        return this->inner.isClientConnected();
+    }
+    bool handOffClient() override { return this->inner.handOffClient(); }
+    std::string getSocketPath() const override {
+        return this->inner.getSocketPath();
+    }
+};
+
+#endif // TAPPEDTRANSPORT_HPP
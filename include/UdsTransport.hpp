@@ -2,8 +2,49 @@
 #define UDSTRANSPORT_HPP
 
 #include "ITransport.hpp"
+#include "LatencyHistogram.hpp"
 #include "Logger.hpp"
+#include "Waker.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Statistiques de la connexion client courante
+ */
+struct TransportStats {
+    uint64_t pingsSent{0};        ///< Nombre de `ping` envoyés
+    uint64_t pongsReceived{0};    ///< Nombre de `pong` reçus à temps
+    uint64_t missedHeartbeats{0}; ///< Nombre de `ping` restés sans réponse
+    LatencyHistogram rtt;         ///< Temps d'aller-retour moteur-UI
+    size_t queueDepth{0};         ///< Messages en attente d'écriture
+    size_t peakQueueDepth{0};     ///< Plus longue file d'envoi observée
+    uint64_t dropped{0};          ///< Messages informatifs abandonnés
+    uint64_t coalesced{0};        ///< Messages informatifs remplacés en file
+    uint64_t overflows{0};        ///< Coupures pour file d'envoi pleine
+    size_t observers{0};          ///< Observateurs actuellement attachés
+};
+
+/**
+ * @brief Politique d'envoi vers un client lent (qui ne lit plus sa socket)
+ * Seuls les messages informatifs (`ping`, `pong`, `gametype`) peuvent être
+ * fusionnés ou abandonnés, jamais `result`, `over`, `error` ni les challenges
+ */
+struct BackpressurePolicy {
+    size_t maxQueued{64};        ///< File au-delà de laquelle on déleste
+    size_t disconnectAfter{256}; ///< File au-delà de laquelle on coupe
+    bool coalesce{true};         ///< Fusion des informatifs (même type/id)
+    std::chrono::milliseconds drainTimeout{500}; ///< Vidage maxi à l'arrêt
+};
 
 /**
  * @brief Implémentation de la communication UI/moteur via Unix Domain Socket
@@ -11,24 +52,189 @@
  */
 class UdsTransport : public ITransport {
   private:
-    const std::string sockPath; ///< Chemin socket Unix
-    int serverSock{-1};         ///< Descripteur socket serveur
-    int clientSock{-1};         ///< Descripteur socket client
+    const std::string sockPath;         ///< Chemin socket Unix
+    int serverSock{-1};                 ///< Descripteur socket serveur
+    int inheritedSock{-1};              ///< Socket d'écoute héritée à adopter
+    bool inherited{false};              ///< serverSock héritée (non détruite)?
+    Waker acceptWake;                   ///< Interrompt waitForClient()
+    std::atomic<int> clientSock{-1};    ///< Descripteur socket client
+    std::atomic<bool> connected{false}; ///< Client connecté (lecture active)?
+    std::thread ioThread;               ///< Thread lecture socket client
+    mutable std::mutex sendMutex;       ///< Protège file d'envoi et écritures
+    std::condition_variable outboxCv;   ///< Signale file d'envoi vidée
+    mutable std::mutex inboxMutex;      ///< Protège file de réception
+    std::condition_variable inboxCv;    ///< Signale message reçu
+    std::deque<Message> inbox;          ///< Messages reçus non encore lus
+    std::string rxBuffer;               ///< Octets reçus non encore découpés
+    Waker wake;                         ///< Réveille le thread I/O
+
+    /// Message sérialisé une seule fois, partagé par toutes les files d'envoi
+    using Frame = std::shared_ptr<const std::string>;
+
+    /**
+     * @brief Message sérialisé en attente d'écriture
+     */
+    struct OutFrame {
+        Frame data;         ///< Octets à écrire
+        std::string type;   ///< Type du message
+        std::string id;     ///< Champ `id` (clé de fusion)
+        bool informational; ///< Peut être fusionné ou abandonné?
+    };
+
+    /**
+     * @brief Connexion observateur (lecture seule) et sa file d'envoi
+     */
+    struct Observer {
+        int fd;                  ///< Descripteur socket observateur
+        std::deque<Frame> queue; ///< Messages en attente d'écriture
+        size_t offset{0};        ///< Octets déjà écrits du premier message
+    };
+    std::deque<OutFrame> outbox; ///< File d'envoi (bornée par la politique)
+    size_t outOffset{0};         ///< Octets déjà écrits du premier message
+    BackpressurePolicy policy;   ///< Politique d'envoi client lent
+    std::string watchPath;       ///< Socket des observateurs (vide = aucune)
+    int watchSock{-1};           ///< Descripteur socket observateurs
+    Waker watchWake;             ///< Réveille le thread observateurs
+    std::atomic<bool> watching{false}; ///< Thread observateurs actif?
+    std::thread watchThread;           ///< Thread accepte/écrit observateurs
+    std::vector<Observer> observers;   ///< Attachés (thread observateurs seul)
+    std::atomic<size_t> observerCount{0}; ///< Nombre d'observateurs attachés
+    std::mutex publishedMutex;            ///< Protège published
+    std::deque<Frame> published;          ///< Diffusés, à répartir
+    std::string handoffPath;         ///< Socket de contrôle (vide = aucune)
+    int handoffSock{-1};             ///< Descripteur socket de contrôle
+    Waker handoffWake;               ///< Réveille le thread de contrôle
+    std::thread handoffThread;       ///< Thread attendant une nouvelle instance
+    std::function<void()> onHandoff; ///< Appelé une fois la socket cédée
+    std::atomic<bool> handedOff{false}; ///< Socket d'écoute cédée?
+    int successorSock{-1};              ///< Connexion vers la nouvelle instance
+    int predecessorSock{-1};            ///< Connexion vers l'ancienne instance
+    std::atomic<bool> detaching{false}; ///< Client à céder, sans le fermer
+    int detachedFd{-1}; ///< Socket client détachée par le thread I/O
+    std::chrono::milliseconds heartbeatInterval{0}; ///< 0 = désactivé
+    uint32_t maxMissedHeartbeats{3}; ///< `ping` sans réponse avant coupure
+    uint64_t pingId{0};              ///< Identifiant du dernier `ping`
+    bool awaitingPong{false};        ///< Dernier `ping` sans réponse?
+    uint32_t missedHeartbeats{0};    ///< `ping` consécutifs sans réponse
+    std::chrono::steady_clock::time_point pingSentAt; ///< Envoi du `ping`
+    mutable std::mutex statsMutex;                    ///< Protège stats, totals
+    TransportStats stats;  ///< Statistiques connexion courante
+    TransportStats totals; ///< Cumul des connexions terminées (stop())
 
   private:
     /**
-     * @brief Sérialise un message en chaîne selon le protocole
-     * @param msg Message à sérialiser
-     * @return Chaîne sérialisée
+     * @brief Boucle de lecture de la socket client (thread dédié)
+     * @param fd Descripteur de la socket client
      */
-    std::string serializeMessage(const Message& msg) const;
+    void ioLoop(int fd);
 
     /**
-     * @brief Parse une chaîne en message selon le protocole
-     * @param data Données à parser
-     * @return Message parsé
+     * @brief Découpe et distribue les messages complets du tampon
+     * Répond aux `ping` et mesure les `pong`, range les autres messages
+     */
+    void dispatchFrames();
+
+    /**
+     * @brief Émet un battement de cœur `ping` si l'échéance est atteinte
+     * @return false si trop de battements sont restés sans réponse
+     */
+    bool heartbeat();
+
+    /**
+     * @brief Traite un `pong` reçu et enregistre le temps d'aller-retour
+     * @param msg Message `pong` reçu
+     */
+    void handlePong(const Message& msg);
+
+    /**
+     * @brief Journalise des statistiques d'envoi (file, délestage, RTT)
+     * Délestages et coupures signalés en erreur pour l'exploitant
+     * @param scope Portée des statistiques (connexion ou instance)
+     * @param s Statistiques à journaliser
+     */
+    static void logStats(const std::string& scope, const TransportStats& s);
+
+    /**
+     * @brief Range un message dans la file d'envoi selon la politique
+     * Appelant détient sendMutex
+     * @param msg Message à envoyer
+     * @param frame Message sérialisé
+     */
+    void enqueue(const Message& msg, const Frame& frame);
+
+    /**
+     * @brief Écrit la file d'envoi sans bloquer (appelant détient sendMutex)
+     * @param fd Descripteur de la socket client
+     * @return false si la socket est en erreur
+     */
+    bool flushOutbox(int fd);
+
+    /**
+     * @brief Écrit sans bloquer le plus de messages possible d'une file
+     * Un seul appel système (sendmsg) pour plusieurs messages
+     * @tparam Queue File de OutFrame ou de Frame
+     * @param fd Descripteur de la socket
+     * @param frames File d'envoi, les messages écrits en sont retirés
+     * @param offset Octets déjà écrits du premier message
+     * @return false si la socket est en erreur
+     */
+    template <typename Queue>
+    static bool flushFrames(int fd, Queue& frames, size_t& offset);
+
+    static const std::string& bytes(const OutFrame& f) { return *f.data; }
+    static const std::string& bytes(const Frame& f) { return *f; }
+
+    /**
+     * @brief Vérifie et prépare une socket d'écoute héritée
+     * @param fd Descripteur hérité
+     * @return true si c'est bien une socket en écoute
+     */
+    static bool prepareInherited(int fd);
+
+    /**
+     * @brief Crée une socket Unix en écoute
+     * @param path Chemin de la socket (remplacée si elle existe)
+     * @return Descripteur de la socket, -1 en cas d'échec
+     */
+    static int listenOn(const std::string& path);
+
+    /**
+     * @brief Diffuse un message déjà sérialisé à tous les observateurs
+     * Coût constant pour l'émetteur, quel que soit le nombre d'observateurs
+     * @param frame Message partagé (aucune copie par observateur)
      */
-    Message parseMessage(const std::string& data) const;
+    void broadcast(const Frame& frame);
+
+    /**
+     * @brief Boucle des observateurs: connexions, écritures, départs
+     */
+    void watchLoop();
+
+    /**
+     * @brief Attend une nouvelle instance et lui cède la socket d'écoute
+     */
+    void handoffLoop();
+
+    /**
+     * @brief Transmet un descripteur à un autre processus (SCM_RIGHTS)
+     * @param sock Socket Unix connectée à l'autre processus
+     * @param fd Descripteur à transmettre (reste ouvert ici)
+     * @return true si transmis
+     */
+    static bool sendFd(int sock, int fd);
+
+    /**
+     * @brief Reçoit un descripteur d'un autre processus (SCM_RIGHTS)
+     * @param sock Socket Unix connectée à l'autre processus
+     * @return Descripteur reçu, -1 si aucun (connexion fermée)
+     */
+    static int receiveFd(int sock);
+
+    /**
+     * @brief Retire le premier message reçu (appelant détient inboxMutex)
+     * @return Premier message, "error" si file vide (client déconnecté)
+     */
+    Message takeMessage();
 
   public:
     UdsTransport(const UdsTransport&) = delete;
@@ -46,6 +252,79 @@ class UdsTransport : public ITransport {
         Logger::log("[UdsTransport] Instance détruite");
     }
 
+    /**
+     * @brief Active les battements de cœur `ping`/`pong` (avant connexion)
+     * @param interval Intervalle entre deux `ping` (0 pour désactiver)
+     * @param maxMissed Nombre de `ping` sans réponse avant déconnexion
+     */
+    void setHeartbeat(std::chrono::milliseconds interval,
+                      uint32_t maxMissed = 3);
+
+    /**
+     * @brief Définit la politique d'envoi vers un client lent
+     * @param backpressure Seuils de délestage et de coupure
+     */
+    void setBackpressure(const BackpressurePolicy& backpressure) {
+        this->policy = backpressure;
+    }
+
+    /**
+     * @brief Accepte des observateurs en lecture seule (avant start())
+     * Ils reçoivent une copie de chaque message envoyé au client, hors
+     * `ping`/`pong`, et tout ce qu'ils envoient est ignoré
+     * @param path Chemin de la socket des observateurs
+     */
+    void enableObservers(std::string path) {
+        this->watchPath = std::move(path);
+    }
+
+    /**
+     * @brief Adopte une socket déjà en écoute au lieu d'en créer une (avant
+     * start()), transmise par le gestionnaire de services ou un processus
+     * parent: les clients peuvent se connecter avant la fin du démarrage
+     * @param fd Descripteur de la socket, désormais détenue par le transport
+     */
+    void adoptListener(int fd) { this->inheritedSock = fd; }
+
+    /**
+     * @brief Accepte de céder la socket d'écoute à une nouvelle instance du
+     * moteur (avant start()), pour une mise à jour sans interruption
+     * @param path Chemin de la socket de contrôle
+     * @param done Appelé (depuis un autre thread) une fois la socket cédée
+     */
+    void enableHandoff(std::string path, std::function<void()> done) {
+        this->handoffPath = std::move(path);
+        this->onHandoff = std::move(done);
+    }
+
+    /**
+     * @brief Prend la socket d'écoute d'une instance en cours (avant start())
+     * Les clients inactifs qu'elle cède ensuite arrivent par waitForClient()
+     * @param path Chemin de la socket de contrôle de l'ancienne instance
+     * @return true si la socket d'écoute a été reçue
+     */
+    bool takeOver(const std::string& path);
+
+    /**
+     * @brief Cède le client, inactif, à la nouvelle instance du moteur
+     * @return true si cédé, sinon le client reste connecté ici
+     */
+    bool handOffClient() override;
+
+    /**
+     * @brief Cherche une socket d'écoute transmise par activation de socket
+     * Convention `LISTEN_PID`/`LISTEN_FDS` (systemd), variables ensuite
+     * retirées de l'environnement pour ne pas les transmettre aux enfants
+     * @return Descripteur de la première socket transmise, -1 si aucune
+     */
+    static int listenFdFromEnv();
+
+    /**
+     * @brief Obtient les statistiques de la connexion courante
+     * @return Copie des compteurs et de l'histogramme des aller-retours
+     */
+    TransportStats getStats() const;
+
     /**
      * @brief Démarre le serveur UDS
      * @return true si démarrage réussi
@@ -53,22 +332,40 @@ class UdsTransport : public ITransport {
     bool start() override;
 
     /**
-     * @brief Attend la connexion d'un client (bloquant)
+     * @brief Attend la connexion d'un client (bloquant, interrompu par stop())
      */
     void waitForClient() override;
 
     /**
-     * @brief Envoie un message au client
+     * @brief Envoie un message au client, sans jamais bloquer
+     * Écrit directement si possible, sinon met en file pour le thread I/O
+     * Appels concurrents sérialisés par sendMutex
      * @param msg Message à envoyer
      */
     void send(const Message& msg) override;
 
     /**
      * @brief Reçoit un message du client (bloquant)
+     * Les `ping`/`pong` sont traités en interne et jamais retournés
      * @return Message reçu
      */
     Message receive() override;
 
+    /**
+     * @brief Reçoit un message du client, en attendant au plus `timeout`
+     * @param timeout Durée d'attente maximale
+     * @return Message reçu ("error" si client déconnecté), vide si délai écoulé
+     */
+    std::optional<Message> receive(std::chrono::milliseconds timeout) override;
+
+    /**
+     * @brief Reçoit un message du client s'il y en a un, sans attendre
+     * @return Message reçu ("error" si client déconnecté), vide sinon
+     */
+    std::optional<Message> tryReceive() override {
+        return receive(std::chrono::milliseconds(0));
+    }
+
     /**
      * @brief Vérifie si un message est disponible
      * @return true si des données attendent d'être lues
@@ -91,6 +388,38 @@ class UdsTransport : public ITransport {
      * @return Chemin de la socket (string)
      */
     std::string getSocketPath() const override { return this->sockPath; }
+
+    /**
+     * @brief Indique si un type de message peut être fusionné ou abandonné
+     * @param type Type du message
+     * @return true pour `ping`, `pong` et `gametype`
+     */
+    static bool isInformational(const std::string& type);
+
+    // Codec du protocole, partagé avec les outils (ex. spload)
+
+    /**
+     * @brief Extrait le premier message complet (terminé par ligne vide)
+     * @param buffer Tampon de réception, consommé en cas de succès
+     * @param frame Message brut extrait
+     * @return true si un message complet a été extrait
+     */
+    static bool extractFrame(std::string& buffer, std::string& frame);
+
+    /**
+     * @brief Sérialise un message en chaîne selon le protocole
+     * @param msg Message à sérialiser
+     * @return Chaîne sérialisée
+     */
+    static std::string serializeMessage(const Message& msg);
+
+    /**
+     * @brief Parse une chaîne en message selon le protocole
+     * Sans effet de bord (aucun log), appelable depuis bancs d'essai et fuzzer
+     * @param data Données à parser
+     * @return Message parsé, de type "error" si la première ligne est vide
+     */
+    static Message parseMessage(const std::string& data);
 };
 
 #endif // UDSTRANSPORT_HPP
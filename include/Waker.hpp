@@ -0,0 +1,39 @@
+#ifndef WAKER_HPP
+#define WAKER_HPP
+
+/**
+ * @brief Réveil d'un thread endormi dans poll(), sans verrou ni blocage
+ * eventfd sous Linux, tube non bloquant ailleurs (macOS)
+ */
+class Waker {
+  private:
+    int readFd{-1};  ///< Surveillé par poll() (POLLIN)
+    int writeFd{-1}; ///< Écrit par notify() (même descripteur si eventfd)
+
+  public:
+    Waker(const Waker&) = delete;
+    Waker& operator=(const Waker&) = delete;
+    Waker(Waker&&) = delete;
+    Waker& operator=(Waker&&) = delete;
+
+    Waker();
+    ~Waker();
+
+    /**
+     * @brief Obtient le descripteur à surveiller (POLLIN si signalé)
+     * @return Descripteur, -1 si création impossible
+     */
+    int fd() const { return this->readFd; }
+
+    /**
+     * @brief Signale le réveil (sans effet s'il est déjà signalé)
+     */
+    void notify() const;
+
+    /**
+     * @brief Acquitte les réveils signalés
+     */
+    void drain() const;
+};
+
+#endif // WAKER_HPP
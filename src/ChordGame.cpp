@@ -1,7 +1,7 @@
 #include "ChordGame.hpp"
 #include "Logger.hpp"
+#include <algorithm>
 #include <chrono>
-#include <thread>
 
 using namespace std::chrono;
 
@@ -17,31 +17,33 @@ ChordGame::ChordGame(ITransport& transport, IMidiInput& midi,
 void ChordGame::start() {
     Logger::log("[ChordGame] Démarrage du jeu d'accords");
     this->challengeId = 0;
+    this->progress = {0, 0, 0, 0};
+    this->pendingNotes.clear();
 }
 
 GameResult ChordGame::play() {
-    GameResult result = {0, 0, 0, 0};
+    GameResult& result = this->progress; // Cumulé si partie reprise
     auto startTime = high_resolution_clock::now();
-    int perfectCount = 0;
-    int partialCount = 0;
     const int maxChallenges = this->config.maxChallenges;
 
-    for (int i = 0; i < maxChallenges; ++i) {
-        // Générer un accord via la factory
-        std::string name;
-        std::vector<std::string> targetNotes;
-        if (withInversions) {
-            auto tuple =
-                factory.generateInversedChord(config.scale, config.mode);
-            name = std::get<0>(tuple);
-            targetNotes = std::get<1>(tuple);
-        } else {
-            auto pair = factory.generateChord(config.scale, config.mode);
-            name = pair.first;
-            targetNotes = pair.second;
+    for (int i = result.total; i < maxChallenges; ++i) {
+        // Générer un accord via la factory, sauf reprise du challenge
+        // interrompu, renvoyé à l'identique
+        if (this->pendingNotes.empty()) {
+            if (withInversions) {
+                auto tuple =
+                    factory.generateInversedChord(config.scale, config.mode);
+                this->pendingName = std::get<0>(tuple);
+                this->pendingNotes = std::get<1>(tuple);
+            } else {
+                auto pair = factory.generateChord(config.scale, config.mode);
+                this->pendingName = pair.first;
+                this->pendingNotes = pair.second;
+            }
+            this->challengeId++;
         }
-
-        this->challengeId++;
+        const std::string name = this->pendingName;
+        const std::vector<std::string> targetNotes = this->pendingNotes;
 
         // Envoyer le challenge
         std::string notesStr;
@@ -58,33 +60,51 @@ GameResult ChordGame::play() {
         Logger::log("[ChordGame] Challenge {}: {}", this->challengeId, name);
 
         // Attendre les notes jouées (non-bloquant avec interruption possible)
-        auto challengeStart = high_resolution_clock::now();
-        std::vector<Note> playedNotes;
+        auto challengeStart = steady_clock::now();
+        std::vector<NoteEvent> playedEvents;
         bool quitRequested = false;
 
-        while (!this->midi.hasNotes()) {
-            if (this->transport.hasMessage()) {
-                Message msg = this->transport.receive();
-                if (msg.getType() == "quit") {
-                    Logger::log(
-                        "[ChordGame] Quitter demandé pendant challenge");
-                    quitRequested = true;
-                    break;
-                }
+        this->midi.expectNotes(targetNotes.size()); // Finalisé sans délai
+
+        // Attente MIDI ou message du client: réveil immédiat sur un accord,
+        // `quit`, déconnexion ou arrêt revérifiés toutes les 10 ms
+        while (true) {
+            if (auto events = this->midi.readEvents(milliseconds(10))) {
+                playedEvents = std::move(*events);
+                break;
+            }
+            if (this->midi.isStopped()) { // stop(): aucune réponse à noter
+                Logger::log("[ChordGame] Entrée MIDI arrêtée");
+                quitRequested = true;
+                break;
+            }
+            auto msg = this->transport.tryReceive();
+            if (msg && (msg->getType() == "quit" ||
+                        !this->transport.isClientConnected())) {
+                Logger::log("[ChordGame] Quitter demandé pendant challenge");
+                quitRequested = true;
+                break;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
 
-        if (quitRequested) {
-            result.total = i;
-            break;
-        }
+        this->midi.expectNotes(0); // Hors challenge: délai seul
+        if (quitRequested) break; // Ce challenge n'est pas compté
 
-        playedNotes = this->midi.readNotes();
-        auto challengeEnd = high_resolution_clock::now();
+        this->pendingNotes.clear();
 
-        auto duration =
-            duration_cast<milliseconds>(challengeEnd - challengeStart).count();
+        // Temps de réaction jusqu'à la première attaque, datée au plus près
+        // du clavier: sans fenêtre d'accord ni délai de lecture
+        std::vector<Note> playedNotes;
+        auto firstOnset = playedEvents.empty()
+                              ? steady_clock::now()
+                              : steady_clock::time_point::max();
+        for (const NoteEvent& event : playedEvents) {
+            playedNotes.push_back(event.note);
+            firstOnset = std::min(firstOnset, event.time);
+        }
+        auto reaction =
+            duration_cast<milliseconds>(firstOnset - challengeStart);
+        auto duration = std::max<int64_t>(0, reaction.count());
 
         // Valider avec AnswerValidator
         std::vector<std::string> playedNotesStr;
@@ -145,39 +165,36 @@ GameResult ChordGame::play() {
         this->factory.feedbackLastChallenge(isPerfect, duration);
 
         if (isPerfect) {
-            perfectCount++;
+            result.perfect++;
             Logger::log("[ChordGame] Résultat: parfait");
         } else if (correctCount > 0) {
-            partialCount++;
+            result.partial++;
             Logger::log("[ChordGame] Résultat: partiel");
         }
 
+        result.total = i + 1;
+
         if (i < maxChallenges - 1) {
             Message readyMsg = this->transport.receive();
             if (readyMsg.getType() == "quit") {
                 Logger::log("[ChordGame] Client demande arrêt session");
-                result.total = i + 1;
                 break;
             }
             if (readyMsg.getType() != "ready") {
                 Logger::err("[ChordGame] Attendu 'ready', reçu '{}'",
                             readyMsg.getType());
-                result.total = i + 1;
                 break;
             }
         }
-        result.total = i + 1;
     }
 
     auto endTime = high_resolution_clock::now();
-    result.duration = duration_cast<milliseconds>(endTime - startTime).count();
-    result.perfect = perfectCount;
-    result.partial = partialCount;
+    result.duration += duration_cast<milliseconds>(endTime - startTime).count();
 
     return result;
 }
 
 void ChordGame::stop() {
     Logger::log("[ChordGame] Arrêt du jeu");
-    this->midi.close();
+    this->midi.pause(); // Périphérique conservé pour la partie suivante
 }
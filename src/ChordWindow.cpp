@@ -0,0 +1,27 @@
+#include "ChordWindow.hpp"
+#include <algorithm>
+
+using namespace std::chrono;
+
+ChordWindow::ChordWindow(ChordWindowPolicy bounds)
+    : policy(bounds), intra(bounds.initial / FACTOR),
+      window(std::clamp<microseconds>(bounds.initial, bounds.minimum,
+                                      bounds.maximum)) {}
+
+void ChordWindow::observe(microseconds interval) {
+    if (interval < microseconds(0)) return;
+    if (interval <= 2 * this->window) {
+        this->intra += (interval - this->intra) / SMOOTHING;
+    } else if (this->inter == microseconds(0)) {
+        this->inter = interval; // Première mesure entre accords
+    } else {
+        this->inter += (interval - this->inter) / SMOOTHING;
+    }
+    // Fenêtre sous l'intervalle entre accords: deux accords jamais fusionnés
+    microseconds lower = this->policy.minimum;
+    microseconds upper = this->policy.maximum;
+    if (this->inter > microseconds(0))
+        upper = std::min(upper, this->inter / 2);
+    this->window =
+        std::clamp(FACTOR * this->intra, lower, std::max(upper, lower));
+}
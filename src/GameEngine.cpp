@@ -2,9 +2,11 @@
 #include "ChordGame.hpp"
 #include "Logger.hpp"
 #include "NoteGame.hpp"
+#include <cstdint>
+#include <format>
+#include <random>
 
 void GameEngine::run() {
-    this->running = true;
     Logger::log("[GameEngine] Démarrage du moteur");
     while (this->running) try {
             handleClientConnection();
@@ -12,17 +14,44 @@ void GameEngine::run() {
         } catch (const std::exception& e) {
             Logger::err("[GameEngine] Exception: {}", e.what());
         }
+    // Fermé par le thread du moteur: plus aucune lecture MIDI en cours
+    awaitMidi(); // Pas de fermeture pendant l'initialisation
+    this->midi.close(); // Seul l'arrêt du moteur ferme le périphérique
     Logger::log("[GameEngine] Moteur arrêté");
 }
 
 void GameEngine::stop() {
     this->running = false;
-    if (this->currentGame) {
-        this->currentGame->stop();
+    {
+        // Partie jamais détruite ni déplacée pendant son arrêt
+        std::lock_guard<std::mutex> lock(this->gameMutex);
+        this->stopped = true;
+        if (this->currentGame) this->currentGame->stop();
     }
     this->transport.stop();
 }
 
+void GameEngine::initializeMidiAsync() {
+    std::lock_guard<std::mutex> lock(this->midiInitMutex);
+    if (this->midiInit.valid() || this->midi.isReady()) return;
+    this->midiInit = std::async(std::launch::async, [this] {
+        auto start = std::chrono::steady_clock::now();
+        bool ready = this->midi.initialize();
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        if (ready)
+            Logger::log("[GameEngine] MIDI prêt en {} ms", elapsed.count());
+        else
+            Logger::err("[GameEngine] MIDI non disponible au démarrage");
+        return ready;
+    });
+}
+
+void GameEngine::awaitMidi() {
+    std::lock_guard<std::mutex> lock(this->midiInitMutex);
+    if (this->midiInit.valid()) this->midiInit.get(); // État gardé par midi
+}
+
 void GameEngine::handleClientConnection() {
     Logger::log("[GameEngine] En attente de connexion client");
     this->transport.waitForClient();
@@ -43,16 +72,21 @@ void GameEngine::handleClientConnection() {
                                      {"keys", std::to_string(g.keys)}}));
         }
     }
-    while (this->transport.isClientConnected()) {
+    // Après drain(), le client inactif (sans partie en cours) est cédé
+    while (this->transport.isClientConnected() && !this->draining) {
         // Attendre un message de configuration
-        Message msg = this->transport.receive();
+        auto next = this->transport.receive(std::chrono::milliseconds(100));
+        if (!next) continue; // Délai écoulé, revérifier drain()
+        Message msg = *next;
         if (msg.getType() == "config") {
             GameConfig config = parseConfig(msg);
             if (config.gameType.empty()) {
                 sendAck(false, "game", "Type de jeu manquant");
                 continue; // Recommencer si config invalide
             }
-            // Initialiser MIDI si nécessaire (erreur non fatale)
+            // Initialiser MIDI si nécessaire (erreur non fatale), sauf si
+            // l'initialisation anticipée a déjà abouti
+            awaitMidi();
             if (!this->midi.isReady() && !this->midi.initialize()) {
                 Logger::err("[GameEngine] MIDI non disponible, en attente...");
                 // Envoyer une erreur mais continuer
@@ -62,8 +96,12 @@ void GameEngine::handleClientConnection() {
                 this->transport.send(error);
                 continue; // Ne pas acquiter si MIDI pas prêt, recommencer
             }
-            sendAck(true);
+            this->suspended.reset(); // Nouvelle partie: l'ancienne est perdue
+            this->sessionToken = newToken();
+            sendAck(true, "", "", config.maxChallenges);
             processGameSession(config);
+        } else if (msg.getType() == "resume") {
+            resumeSession(msg.getField("token"));
         } else if (msg.getType() == "quit") {
             Logger::log(
                 "[GameEngine] Client demande retour à l'état non configuré");
@@ -76,13 +114,22 @@ void GameEngine::handleClientConnection() {
             this->transport.send(error);
         }
     }
+    if (this->draining && this->transport.handOffClient()) {
+        Logger::log("[GameEngine] Client confié à la nouvelle instance");
+        return;
+    }
     Logger::log("[GameEngine] Client déconnecté");
 }
 
-void GameEngine::processGameSession(const GameConfig& config) {
-    Logger::log("[GameEngine] Démarrage session: {}", config.gameType);
+void GameEngine::processGameSession(const GameConfig& config,
+                                    std::optional<GameResult> resumed) {
+    Logger::log("[GameEngine] {} session: {}",
+                resumed ? "Reprise" : "Démarrage", config.gameType);
     // Créer le mode de jeu approprié
-    this->currentGame = createGameMode(config);
+    if (!resumed) {
+        std::lock_guard<std::mutex> lock(this->gameMutex);
+        this->currentGame = createGameMode(config);
+    }
     if (!this->currentGame) {
         Message error("error", {{"code", "internal"},
                                 {"message", "Mode de jeu non supporté"}});
@@ -103,6 +150,8 @@ void GameEngine::processGameSession(const GameConfig& config) {
                         readyMsg.getType());
             if (!this->transport.isClientConnected()) {
                 Logger::err("[GameEngine] Transport déconnecté, arrêt session");
+                suspendSession(config,
+                               resumed.value_or(GameResult{0, 0, 0, 0}));
                 return;
             }
             Message error("error",
@@ -111,9 +160,20 @@ void GameEngine::processGameSession(const GameConfig& config) {
             this->transport.send(error);
             continue;
         }
-        // Lancer la partie
-        this->currentGame->start();
+        // Lancer la partie (ou la poursuivre)
+        if (!resumed) this->currentGame->start();
+        {
+            // Reprise avant tout stop() concurrent, jamais après
+            std::lock_guard<std::mutex> lock(this->gameMutex);
+            if (this->stopped) return;
+            this->midi.resume(); // Suspendue à l'arrêt de la partie précédente
+        }
         GameResult result = this->currentGame->play();
+        if (!this->transport.isClientConnected() &&
+            result.total < config.maxChallenges) {
+            suspendSession(config, result);
+            return; // Pas de `over`: la partie n'est pas finie
+        }
         // Envoyer le résultat final (sans score)
         std::map<std::string, std::string> overFields{
             {"duration", std::to_string(result.duration)},
@@ -129,6 +189,50 @@ void GameEngine::processGameSession(const GameConfig& config) {
     }
 }
 
+void GameEngine::suspendSession(const GameConfig& config,
+                                const GameResult& progress) {
+    if (this->resumeGrace.count() <= 0 || !this->currentGame) return;
+    std::lock_guard<std::mutex> lock(this->gameMutex);
+    this->suspended = SuspendedSession{
+        this->sessionToken, config, std::move(this->currentGame), progress,
+        std::chrono::steady_clock::now() + this->resumeGrace};
+    Logger::log("[GameEngine] Partie suspendue après {} challenge(s), "
+                "reprise possible pendant {} s",
+                progress.total, this->resumeGrace.count());
+}
+
+void GameEngine::resumeSession(const std::string& token) {
+    if (this->suspended &&
+        std::chrono::steady_clock::now() > this->suspended->expiry) {
+        Logger::log("[GameEngine] Délai de reprise expiré");
+        this->suspended.reset();
+    }
+    if (!this->suspended || token.empty() || this->suspended->token != token) {
+        sendAck(false, "resume", "Session introuvable ou expirée");
+        return;
+    }
+    SuspendedSession session = std::move(*this->suspended);
+    this->suspended.reset();
+    {
+        std::lock_guard<std::mutex> lock(this->gameMutex);
+        this->currentGame = std::move(session.game);
+    }
+    this->sessionToken = session.token;
+    Logger::log("[GameEngine] Reprise après {} challenge(s)",
+                session.progress.total);
+    this->transport.send(
+        Message("ack", {{"status", "ok"},
+                        {"token", session.token},
+                        {"total", std::to_string(session.progress.total)}}));
+    processGameSession(session.config, session.progress);
+}
+
+std::string GameEngine::newToken() {
+    static std::random_device device;
+    std::uniform_int_distribution<uint64_t> dist;
+    return std::format("{:016x}{:016x}", dist(device), dist(device));
+}
+
 std::unique_ptr<IGameMode>
 GameEngine::createGameMode(const GameConfig& config) {
     if (config.gameType == "note")
@@ -155,13 +259,28 @@ GameConfig GameEngine::parseConfig(const Message& msg) {
 }
 
 void GameEngine::sendAck(bool ok, const std::string& errorCode,
-                         const std::string& errorMessage) {
+                         const std::string& errorMessage, int challenges) {
     std::map<std::string, std::string> ackFields{
         {"status", ok ? "ok" : "error"}};
-    if (!ok) {
+    if (ok) {
+        ackFields["token"] = this->sessionToken; // Pour reprendre la partie
+        if (challenges > 0)
+            ackFields["challenges"] = std::to_string(challenges);
+    } else {
         if (!errorCode.empty()) ackFields["code"] = errorCode;
         if (!errorMessage.empty()) ackFields["message"] = errorMessage;
     }
     Message ack("ack", ackFields);
     this->transport.send(ack);
 }
+
+void GameEngine::sendDevice(const std::string& name, unsigned device,
+                            bool connected) {
+    Logger::log("[GameEngine] Périphérique MIDI {} {}: {}", device,
+                connected ? "branché" : "débranché", name);
+    if (!this->transport.isClientConnected()) return; // Aucun client
+    std::string state = connected ? "connected" : "disconnected";
+    this->transport.send(Message("device", {{"id", std::to_string(device)},
+                                            {"name", name},
+                                            {"state", state}}));
+}
@@ -0,0 +1,45 @@
+#include "LatencyHistogram.hpp"
+#include <algorithm>
+#include <bit>
+#include <format>
+
+void LatencyHistogram::record(std::chrono::nanoseconds latency) {
+    uint64_t us = std::max<int64_t>(
+        0, std::chrono::duration_cast<std::chrono::microseconds>(latency)
+               .count());
+    // Seau = position du bit de poids fort (0 et 1 µs dans le premier)
+    size_t bucket = us ? static_cast<size_t>(std::bit_width(us)) - 1 : 0;
+    this->buckets[std::min(bucket, BUCKETS - 1)]++;
+    this->samples++;
+    this->totalUs += us;
+    this->minUs = std::min(this->minUs, us);
+    this->maxUs = std::max(this->maxUs, us);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < BUCKETS; ++i) this->buckets[i] += other.buckets[i];
+    this->samples += other.samples;
+    this->totalUs += other.totalUs;
+    this->minUs = std::min(this->minUs, other.minUs);
+    this->maxUs = std::max(this->maxUs, other.maxUs);
+}
+
+uint64_t LatencyHistogram::percentileUs(double p) const {
+    if (this->samples == 0) return 0;
+    auto rank = static_cast<uint64_t>(
+        std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(samples));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += this->buckets[i];
+        // Borne haute du seau, sans dépasser le maximum réellement observé
+        if (seen > rank || seen == this->samples)
+            return std::min((uint64_t{1} << (i + 1)) - 1, this->maxUs);
+    }
+    return this->maxUs; // COUVERTURE: Inatteignable, seen finit à samples
+}
+
+std::string LatencyHistogram::summary() const {
+    return std::format("n={} min={} p50={} p90={} p99={} max={} (µs)",
+                       this->samples, min(), percentileUs(50),
+                       percentileUs(90), percentileUs(99), this->maxUs);
+}
@@ -0,0 +1,197 @@
+#include "MidiFile.hpp"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+/// Message d'une piste daté en ticks, avant application des tempos
+struct TickEvent {
+    uint64_t tick{0};   ///< Position depuis le début de la piste
+    uint32_t tempo{0};  ///< µs par noire si changement de tempo, sinon 0
+    MidiFileEvent midi; ///< Message de canal (sans objet si tempo)
+};
+
+/// Lecture des octets d'une piste, bornée par la longueur de son bloc
+class TrackReader {
+  private:
+    const std::vector<uint8_t>& data; ///< Contenu du bloc MTrk
+    size_t pos{0};                    ///< Prochain octet lu
+
+  public:
+    explicit TrackReader(const std::vector<uint8_t>& bytes) : data(bytes) {}
+
+    [[nodiscard]] bool done() const { return this->pos >= this->data.size(); }
+
+    uint8_t byte() {
+        if (done()) throw std::runtime_error("MIDI file: truncated track");
+        return this->data[this->pos++];
+    }
+
+    /// Quantité de longueur variable (7 bits par octet, 4 octets au plus)
+    uint32_t varLen() {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            uint8_t b = byte();
+            value = (value << 7) | (b & 0x7F);
+            if (!(b & 0x80)) return value;
+        }
+        throw std::runtime_error("MIDI file: variable length too long");
+    }
+
+    void skip(uint32_t count) {
+        if (count > this->data.size() - this->pos)
+            throw std::runtime_error("MIDI file: truncated event");
+        this->pos += count;
+    }
+};
+
+/**
+ * @brief Lit un entier gros-boutiste (big-endian) depuis le flux
+ * @param in Flux binaire
+ * @param size Nombre d'octets (4 au plus)
+ * @return Valeur lue
+ */
+uint32_t readBigEndian(std::istream& in, int size) {
+    std::array<char, 4> bytes{};
+    if (!in.read(bytes.data(), size))
+        throw std::runtime_error("MIDI file: truncated chunk");
+    uint32_t value = 0;
+    for (int i = 0; i < size; ++i)
+        value = (value << 8) | static_cast<uint8_t>(bytes[i]);
+    return value;
+}
+
+/**
+ * @brief Lit l'en-tête d'un bloc (identifiant et longueur)
+ * @param in Flux binaire
+ * @param id Identifiant lu (ex: "MTrk")
+ * @param length Longueur du bloc lue
+ * @return false en fin de flux
+ */
+bool readChunkHeader(std::istream& in, std::string& id, uint32_t& length) {
+    std::array<char, 4> tag{};
+    if (!in.read(tag.data(), tag.size())) return false;
+    id.assign(tag.data(), tag.size());
+    length = readBigEndian(in, 4);
+    return true;
+}
+
+/**
+ * @brief Décode les messages d'une piste
+ * @param data Contenu du bloc MTrk
+ * @param track Index de la piste
+ * @param out Messages datés en ticks, ajoutés à la suite
+ */
+void parseTrack(const std::vector<uint8_t>& data, uint16_t track,
+                std::vector<TickEvent>& out) {
+    TrackReader reader(data);
+    uint64_t tick = 0;
+    // Statut courant, repris si l'octet est une donnée. Conservé après méta
+    // et exclusif: les fichiers conformes ne s'en servent pas, d'autres si
+    uint8_t running = 0;
+    while (!reader.done()) {
+        tick += reader.varLen();
+        uint8_t status = reader.byte();
+        if (status == 0xFF) { // Méta-événement
+            uint8_t type = reader.byte();
+            uint32_t length = reader.varLen();
+            if (type == 0x2F) return; // Fin de piste
+            if (type == 0x51 && length == 3) {
+                uint32_t tempo = reader.byte() << 16;
+                tempo |= reader.byte() << 8;
+                tempo |= reader.byte();
+                if (tempo > 0)
+                    out.push_back({.tick = tick, .tempo = tempo, .midi = {}});
+                continue;
+            }
+            reader.skip(length);
+            continue;
+        }
+        if (status == 0xF0 || status == 0xF7) { // Exclusif système
+            reader.skip(reader.varLen());
+            continue;
+        }
+        uint8_t data1 = 0;
+        if (status < 0x80) { // Donnée: statut du message précédent
+            if (running == 0)
+                throw std::runtime_error("MIDI file: data without status");
+            data1 = status;
+            status = running;
+        } else if (status >= 0xF0) {
+            throw std::runtime_error("MIDI file: unexpected system message");
+        } else {
+            running = status;
+            data1 = reader.byte();
+        }
+        // Changement de programme et pression de canal: une seule donnée
+        uint8_t type = status & 0xF0;
+        uint8_t data2 = (type == 0xC0 || type == 0xD0) ? 0 : reader.byte();
+        out.push_back({.tick = tick,
+                       .midi = {.status = status,
+                                .data1 = static_cast<uint8_t>(data1 & 0x7F),
+                                .data2 = static_cast<uint8_t>(data2 & 0x7F),
+                                .track = track}});
+    }
+}
+
+} // namespace
+
+MidiFile MidiFile::parse(std::istream& in) {
+    std::string id;
+    uint32_t length = 0;
+    if (!readChunkHeader(in, id, length) || id != "MThd" || length < 6)
+        throw std::runtime_error("MIDI file: missing MThd header");
+    MidiFile file;
+    file.format = static_cast<uint16_t>(readBigEndian(in, 2));
+    uint16_t declared = static_cast<uint16_t>(readBigEndian(in, 2));
+    uint16_t division = static_cast<uint16_t>(readBigEndian(in, 2));
+    in.ignore(length - 6); // En-tête étendu par une version ultérieure
+    if (division == 0) throw std::runtime_error("MIDI file: null division");
+
+    // Blocs lus un à un: seule la piste en cours est en mémoire
+    std::vector<TickEvent> ticks;
+    std::vector<uint8_t> chunk;
+    while (file.tracks < declared && readChunkHeader(in, id, length)) {
+        if (id != "MTrk") { // Bloc inconnu ignoré, comme le veut la norme
+            in.ignore(length);
+            continue;
+        }
+        chunk.resize(length);
+        if (!in.read(reinterpret_cast<char*>(chunk.data()), length))
+            throw std::runtime_error("MIDI file: truncated track");
+        parseTrack(chunk, file.tracks++, ticks);
+    }
+
+    // Pistes fusionnées, ordre des pistes conservé pour un même tick
+    std::ranges::stable_sort(ticks, {}, &TickEvent::tick);
+    // SMPTE (octet de poids fort négatif): durée d'un tick fixe
+    bool smpte = division & 0x8000;
+    uint64_t ticksPerUnit =
+        smpte ? static_cast<uint64_t>(-static_cast<int8_t>(division >> 8)) *
+                    (division & 0xFF)
+              : division;
+    if (ticksPerUnit == 0) throw std::runtime_error("MIDI file: null SMPTE");
+    uint64_t tempo = smpte ? 1'000'000 : 500'000; // µs par seconde ou noire
+    uint64_t lastTick = 0;
+    uint64_t elapsed = 0; // µs × ticksPerUnit, exact malgré les tempos
+    for (const TickEvent& event : ticks) {
+        elapsed += (event.tick - lastTick) * tempo;
+        lastTick = event.tick;
+        if (event.tempo > 0) {
+            if (!smpte) tempo = event.tempo; // SMPTE: tempo sans effet
+            continue;
+        }
+        MidiFileEvent midi = event.midi;
+        midi.time = std::chrono::microseconds(elapsed / ticksPerUnit);
+        file.events.push_back(midi);
+    }
+    return file;
+}
+
+MidiFile MidiFile::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("MIDI file: cannot open " + path);
+    return parse(in);
+}
@@ -0,0 +1,155 @@
+#include "MidiFileInput.hpp"
+#include "HeldKeys.hpp"
+#include "Logger.hpp"
+#include "MidiFile.hpp"
+#include "MidiNotes.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+MidiFileInput::MidiFileInput(std::string filePath, double playbackSpeed)
+    : path(std::move(filePath)), speed(std::max(0.0, playbackSpeed)) {
+    Logger::log("[MidiFileInput] Instance créée");
+}
+
+bool MidiFileInput::initialize() {
+    Logger::log("[MidiFileInput] Lecture du fichier: {}", this->path);
+    std::vector<Onset> read;
+    try {
+        MidiFile file = MidiFile::load(this->path);
+        for (const MidiFileEvent& event : file.getEvents()) {
+            // Note On de vélocité nulle: relâchement, ignoré comme Note Off
+            if ((event.status & 0xF0) != 0x90 || event.data2 == 0) continue;
+            if (!MIDI_NOTE_NAMES[event.data1].playable()) continue;
+            read.push_back({.time = event.time,
+                            .midi = event.data1,
+                            .velocity = event.data2,
+                            .track = event.track});
+        }
+        Logger::log("[MidiFileInput] {} attaque(s) sur {} piste(s)",
+                    std::to_string(read.size()),
+                    std::to_string(file.getTracks()));
+    } catch (const std::runtime_error& e) {
+        Logger::err("[MidiFileInput] Fichier illisible: {}", e.what());
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(this->mtx);
+    this->onsets = std::move(read);
+    this->next = 0;
+    this->chordWindow = ChordWindow(this->policy);
+    this->start = std::chrono::steady_clock::now();
+    this->paused = false;
+    this->ready = true;
+    return true;
+}
+
+std::vector<Note> MidiFileInput::readNotes() {
+    std::optional<std::vector<Note>> notes;
+    while (!(notes = readNotes(std::chrono::hours(1))))
+        if (isStopped()) return {}; // Fermée
+    return std::move(*notes);
+}
+
+std::optional<std::vector<NoteEvent>>
+MidiFileInput::readEvents(std::chrono::milliseconds timeout) {
+    using namespace std::chrono;
+    auto deadline = steady_clock::now() + timeout;
+    std::unique_lock<std::mutex> lock(this->mtx);
+    std::optional<Chord> chord;
+    // Accord recalculé à chaque réveil: expectNotes() peut l'avoir complété
+    while (this->ready && !this->paused) {
+        chord = nextChord();
+        auto due = chord ? at(chord->due) : steady_clock::time_point::max();
+        auto now = steady_clock::now();
+        if (due <= now) break;
+        if (now >= deadline) return std::nullopt;
+        this->cv.wait_until(lock, std::min(due, deadline));
+    }
+    if (!this->ready || this->paused)
+        return std::nullopt; // Fermée ou en pause: isStopped()
+    std::vector<NoteEvent> events;
+    for (size_t i = this->next; i < chord->end; ++i) {
+        const Onset& onset = this->onsets[i];
+        events.push_back(
+            {.midi = onset.midi,
+             .velocity = onset.velocity,
+             .device = onset.track,
+             .note = midiToNote(onset.midi),
+             .time = this->speed > 0 ? at(onset.time) : steady_clock::now()});
+    }
+    this->next = chord->end;
+    this->chordWindow = chord->window;
+    return events;
+}
+
+void MidiFileInput::expectNotes(size_t count) {
+    this->expectedNotes = count;
+    this->cv.notify_all(); // Accord suivant peut-être déjà complet
+}
+
+bool MidiFileInput::hasNotes() const {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (!this->ready || this->paused) return false;
+    auto chord = nextChord();
+    return chord && at(chord->due) <= std::chrono::steady_clock::now();
+}
+
+void MidiFileInput::pause() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (!this->ready || this->paused) return;
+    this->paused = true;
+    this->pausedAt = std::chrono::steady_clock::now();
+    this->cv.notify_all(); // Débloque un readEvents() en attente
+}
+
+void MidiFileInput::resume() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (!this->paused) return;
+    this->paused = false;
+    // Lecture reprise où elle s'était arrêtée: durée de la pause décomptée
+    this->start += std::chrono::steady_clock::now() - this->pausedAt;
+}
+
+void MidiFileInput::close() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (!this->ready) return;
+    this->ready = false;
+    this->cv.notify_all(); // Débloque un readEvents() en attente
+    Logger::log("[MidiFileInput] Lecture arrêtée ({} attaque(s) restantes)",
+                std::to_string(this->onsets.size() - this->next));
+}
+
+std::optional<MidiFileInput::Chord> MidiFileInput::nextChord() const {
+    if (this->next >= this->onsets.size()) return std::nullopt;
+    // Mêmes règles que RtMidiInput en mode Window: une attaque rejoint
+    // l'accord si elle précède l'échéance fixée par la précédente
+    Chord chord{.end = this->next + 1, .due = {}, .window = this->chordWindow};
+    if (this->next > 0)
+        chord.window.observe(this->onsets[this->next].time -
+                             this->onsets[this->next - 1].time);
+    size_t expected = this->expectedNotes;
+    HeldKeys distinct; // Note répétée comptée une fois
+    distinct.press(this->onsets[this->next].midi);
+    while (chord.end < this->onsets.size() &&
+           (expected == 0 || distinct.count() < expected)) {
+        auto gap = this->onsets[chord.end].time -
+                   this->onsets[chord.end - 1].time;
+        if (gap >= chord.window.current()) break;
+        chord.window.observe(gap);
+        distinct.press(this->onsets[chord.end].midi);
+        chord.end++;
+    }
+    auto last = this->onsets[chord.end - 1].time;
+    bool complete = expected > 0 && distinct.count() >= expected;
+    chord.due = complete ? last : last + chord.window.current();
+    return chord;
+}
+
+std::chrono::steady_clock::time_point
+MidiFileInput::at(std::chrono::microseconds time) const {
+    if (this->speed <= 0) return this->start; // Sans attente: déjà échue
+    return this->start +
+           std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+               std::chrono::duration<double, std::micro>(time.count() /
+                                                         this->speed));
+}
@@ -1,7 +1,7 @@
 #include "NoteGame.hpp"
 #include "Logger.hpp"
+#include <algorithm>
 #include <chrono>
-#include <thread>
 
 using namespace std::chrono;
 
@@ -15,18 +15,22 @@ NoteGame::NoteGame(ITransport& transport, IMidiInput& midi,
 void NoteGame::start() {
     Logger::log("[NoteGame] Démarrage du jeu de notes");
     this->challengeId = 0;
+    this->progress = {0, 0, 0, 0};
+    this->pendingNote.clear();
 }
 
 GameResult NoteGame::play() {
-    GameResult result = {0, 0, 0, 0};
+    GameResult& result = this->progress; // Cumulé si partie reprise
     auto startTime = high_resolution_clock::now();
-    int perfectCount = 0;
     const int maxChallenges = this->config.maxChallenges;
 
-    for (int i = 0; i < maxChallenges; ++i) {
-        std::string targetNoteStr =
-            factory.generateNote(config.scale, config.mode);
-        this->challengeId++;
+    for (int i = result.total; i < maxChallenges; ++i) {
+        // Reprise: le challenge interrompu est renvoyé à l'identique
+        if (this->pendingNote.empty()) {
+            this->pendingNote = factory.generateNote(config.scale, config.mode);
+            this->challengeId++;
+        }
+        const std::string targetNoteStr = this->pendingNote;
 
         Message challenge("note", {{"note", targetNoteStr},
                                    {"id", std::to_string(this->challengeId)}});
@@ -35,34 +39,51 @@ GameResult NoteGame::play() {
         Logger::log("[NoteGame] Défi {} envoyé: {}", this->challengeId,
                     targetNoteStr);
 
-        auto challengeStart = high_resolution_clock::now();
-        std::vector<Note> playedNotes;
+        auto challengeStart = steady_clock::now();
+        std::vector<NoteEvent> playedEvents;
         bool quitRequested = false;
 
-        // Boucle d'attente non-bloquante pour MIDI ou Transport
-        while (!this->midi.hasNotes()) {
-            if (this->transport.hasMessage()) {
-                Message msg = this->transport.receive();
-                if (msg.getType() == "quit") {
-                    Logger::log(
-                        "[NoteGame] Quitter demandé pendant le challenge");
-                    quitRequested = true;
-                    break;
-                }
+        this->midi.expectNotes(1); // Finalisé sans délai
+
+        // Attente MIDI ou message du client: réveil immédiat sur un accord,
+        // `quit`, déconnexion ou arrêt revérifiés toutes les 10 ms
+        while (true) {
+            if (auto events = this->midi.readEvents(milliseconds(10))) {
+                playedEvents = std::move(*events);
+                break;
+            }
+            if (this->midi.isStopped()) { // stop(): aucune réponse à noter
+                Logger::log("[NoteGame] Entrée MIDI arrêtée");
+                quitRequested = true;
+                break;
+            }
+            auto msg = this->transport.tryReceive();
+            if (msg && (msg->getType() == "quit" ||
+                        !this->transport.isClientConnected())) {
+                Logger::log("[NoteGame] Quitter demandé pendant le challenge");
+                quitRequested = true;
+                break;
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
 
-        if (quitRequested) {
-            result.total = i; // Ce challenge n'est pas compté
-            break;
-        }
+        this->midi.expectNotes(0); // Hors challenge: délai seul
+        if (quitRequested) break; // Ce challenge n'est pas compté
 
-        playedNotes = this->midi.readNotes();
-        auto challengeEnd = high_resolution_clock::now();
+        this->pendingNote.clear();
 
-        auto duration =
-            duration_cast<milliseconds>(challengeEnd - challengeStart).count();
+        // Temps de réaction jusqu'à la première attaque, datée au plus près
+        // du clavier: sans fenêtre d'accord ni délai de lecture
+        std::vector<Note> playedNotes;
+        auto firstOnset = playedEvents.empty()
+                              ? steady_clock::now()
+                              : steady_clock::time_point::max();
+        for (const NoteEvent& event : playedEvents) {
+            playedNotes.push_back(event.note);
+            firstOnset = std::min(firstOnset, event.time);
+        }
+        auto reaction =
+            duration_cast<milliseconds>(firstOnset - challengeStart);
+        auto duration = std::max<int64_t>(0, reaction.count());
 
         bool correct = false;
         std::string correctNotes;
@@ -96,7 +117,7 @@ GameResult NoteGame::play() {
         }
 
         if (correct && incorrectNotes.empty() && playedNotes.size() == 1) {
-            perfectCount++;
+            result.perfect++;
         }
 
         this->factory.feedbackLastChallenge(correct && incorrectNotes.empty() &&
@@ -104,33 +125,30 @@ GameResult NoteGame::play() {
                                             duration);
 
         this->transport.send(Message("result", resultFields));
+        result.total = i + 1;
 
         if (i < maxChallenges - 1) {
             Message readyMsg = this->transport.receive();
             if (readyMsg.getType() == "quit") {
                 Logger::log(
                     "[NoteGame] Client demande arrêt pendant la session");
-                result.total = i + 1;
                 break;
             }
             if (readyMsg.getType() != "ready") {
                 Logger::err("[NoteGame] Attendu 'ready', reçu '{}'",
                             readyMsg.getType());
-                result.total = i + 1;
                 break;
             }
         }
-        result.total = i + 1;
     }
 
     auto endTime = high_resolution_clock::now();
-    result.duration = duration_cast<milliseconds>(endTime - startTime).count();
-    result.perfect = perfectCount;
+    result.duration += duration_cast<milliseconds>(endTime - startTime).count();
 
     return result;
 }
 
 void NoteGame::stop() {
     Logger::log("[NoteGame] Arrêt du jeu");
-    this->midi.close();
+    this->midi.pause(); // Périphérique conservé pour la partie suivante
 }
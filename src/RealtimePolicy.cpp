@@ -0,0 +1,55 @@
+#include "RealtimePolicy.hpp"
+#include "Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+
+bool applyRealtimePolicy(const RealtimePolicy& policy,
+                         const std::string& name) {
+    bool applied = true;
+    if (policy.priority > 0) {
+        int sched = policy.roundRobin ? SCHED_RR : SCHED_FIFO;
+        sched_param param{};
+        param.sched_priority =
+            std::clamp(policy.priority, sched_get_priority_min(sched),
+                       sched_get_priority_max(sched));
+        // Sans CAP_SYS_NICE ni RLIMIT_RTPRIO: EPERM, thread inchangé
+        int status = pthread_setschedparam(pthread_self(), sched, &param);
+        if (status == 0) {
+            Logger::log("[{}] Priorité temps réel {} ({})", name,
+                        param.sched_priority,
+                        policy.roundRobin ? "SCHED_RR" : "SCHED_FIFO");
+        } else {
+            Logger::err("[{}] Priorité temps réel refusée ({}), "
+                        "ordonnancement normal",
+                        name, std::strerror(status));
+            applied = false;
+        }
+    }
+    if (policy.cpu >= 0) {
+#ifdef __linux__
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        int status = EINVAL;
+        if (policy.cpu < CPU_SETSIZE) {
+            CPU_SET(policy.cpu, &cpus);
+            status = pthread_setaffinity_np(pthread_self(), sizeof(cpus),
+                                            &cpus);
+        }
+        if (status == 0) {
+            Logger::log("[{}] Épinglé sur le cœur {}", name, policy.cpu);
+        } else {
+            Logger::err("[{}] Cœur {} refusé ({}), tous les cœurs permis",
+                        name, policy.cpu, std::strerror(status));
+            applied = false;
+        }
+#else
+        // COUVERTURE: macOS n'offre que des indications d'affinité
+        Logger::err("[{}] Affinité CPU non prise en charge", name);
+        applied = false;
+#endif
+    }
+    return applied;
+}
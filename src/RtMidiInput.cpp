@@ -1,14 +1,24 @@
 #include "RtMidiInput.hpp"
 #include "Logger.hpp"
+#include "MidiNotes.hpp"
+#include <algorithm>
 #include <chrono>
-#include <cstdlib>
-#include <map>
+#include <poll.h>
 #include <rtmidi/RtMidi.h>
 #include <thread>
+#ifdef __linux__
+#include <alsa/asoundlib.h>
+#endif
 
 // Wrappers implementation
 class RtMidiInImpl : public IRtMidiIn {
     RtMidiIn* midi;
+    Callback callback; ///< Appelé par dispatch() depuis le thread RtMidi
+
+    static void dispatch(double deltaTime, std::vector<unsigned char>* message,
+                         void* self) {
+        static_cast<RtMidiInImpl*>(self)->callback(deltaTime, message);
+    }
 
   public:
     RtMidiInImpl() {
@@ -28,6 +38,11 @@ class RtMidiInImpl : public IRtMidiIn {
     double getMessage(std::vector<unsigned char>* message) override {
         return midi->getMessage(message);
     }
+    void setCallback(Callback cb) override {
+        callback = std::move(cb);
+        midi->setCallback(&RtMidiInImpl::dispatch, this);
+    }
+    void cancelCallback() override { midi->cancelCallback(); }
     unsigned int getPortCount() override { return midi->getPortCount(); }
     std::string getPortName(unsigned int portNumber) override {
         return midi->getPortName(portNumber);
@@ -55,8 +70,68 @@ class RtMidiOutImpl : public IRtMidiOut {
     }
 };
 
+#ifdef __linux__
+class AlsaMidiRouter : public IMidiRouter {
+    snd_seq_t* seq = nullptr;
+    int openStatus; ///< Résultat de l'ouverture du séquenceur
+
+    /// Résout une adresse de port, erreur ALSA journalisée
+    bool parse(snd_seq_addr_t& addr, const std::string& name) {
+        int status = snd_seq_parse_address(seq, &addr, name.c_str());
+        if (status < 0)
+            Logger::err("[RtMidiInput] Port ALSA '{}' introuvable: {}", name,
+                        snd_strerror(status));
+        return status >= 0;
+    }
+
+  public:
+    AlsaMidiRouter() {
+        openStatus = snd_seq_open(&seq, "default", SND_SEQ_OPEN_DUPLEX, 0);
+        if (openStatus >= 0)
+            snd_seq_set_client_name(seq, "SmartPianoEngine Router");
+    }
+    ~AlsaMidiRouter() override {
+        if (openStatus >= 0) snd_seq_close(seq);
+    }
+    bool connect(const std::string& source,
+                 const std::string& destination) override {
+        if (openStatus < 0) {
+            Logger::err("[RtMidiInput] Séquenceur ALSA indisponible: {}",
+                        snd_strerror(openStatus));
+            return false;
+        }
+        snd_seq_addr_t sender;
+        snd_seq_addr_t dest;
+        if (!parse(sender, source) || !parse(dest, destination)) return false;
+        snd_seq_port_subscribe_t* subscription;
+        snd_seq_port_subscribe_alloca(&subscription);
+        snd_seq_port_subscribe_set_sender(subscription, &sender);
+        snd_seq_port_subscribe_set_dest(subscription, &dest);
+        if (snd_seq_get_port_subscription(seq, subscription) == 0)
+            return true; // Déjà connectés (ex: instance précédente)
+        int status = snd_seq_subscribe_port(seq, subscription);
+        if (status < 0)
+            Logger::err("[RtMidiInput] Abonnement ALSA {} -> {} refusé: {}",
+                        source, destination, snd_strerror(status));
+        return status >= 0;
+    }
+};
+#else
+class AlsaMidiRouter : public IMidiRouter {
+  public:
+    bool connect(const std::string& source,
+                 const std::string& destination) override {
+        Logger::err("[RtMidiInput] Routage {} -> {} non pris en charge hors "
+                    "ALSA",
+                    source, destination);
+        return false;
+    }
+};
+#endif
+
 bool RtMidiInput::initialize() {
     Logger::log("[RtMidiInput] Initialisation MIDI");
+    std::unique_ptr<IRtMidiIn> midiIn;
     try {
         midiIn = createMidiIn();
         midiOut = createMidiOut();
@@ -68,32 +143,35 @@ bool RtMidiInput::initialize() {
     }
     try {
         // Essayer de détecter un clavier matériel
-        unsigned int nPorts = midiIn->getPortCount();
+        IRtMidiIn* probe = midiIn.get(); // Conservé par le premier port
+        unsigned int nPorts = probe->getPortCount();
         bool hardwareFound = false;
         Logger::log("[RtMidiInput] Nombre de ports MIDI trouvés: {}",
                     std::to_string(nPorts));
 
-        unsigned int hardwarePortIndex = 0;
+        std::vector<unsigned int> hardwarePorts;
         for (unsigned int i = 0; i < nPorts; i++) {
-            std::string portName = midiIn->getPortName(i);
+            std::string portName = probe->getPortName(i);
             Logger::log("[RtMidiInput] Port {}: {}", std::to_string(i),
                         portName);
-            // On cherche un clavier (ex: "reface CP", "USB MIDI", etc.)
-            // On évite de se connecter à soi-même, "Midi Through", ou
-            // "FluidSynth"
-            if (portName.find("SmartPianoEngine") == std::string::npos &&
-                portName.find("Through") == std::string::npos &&
-                portName.find("FluidSynth") == std::string::npos &&
-                portName.find("fluidsynth") == std::string::npos &&
-                portName.find("FLUID Synth") == std::string::npos) {
+            if (isHardwarePort(portName)) {
+                if (maxPorts != 0 && hardwarePorts.size() >= maxPorts) {
+                    Logger::log("[RtMidiInput] Port ignoré (maximum {}): {}",
+                                std::to_string(maxPorts), portName);
+                    continue;
+                }
                 Logger::log("[RtMidiInput] Tentative d'ouverture du port: {}",
                             portName);
-                midiIn->openPort(i);
+                // Une instance RtMidi par port, la première sert à l'énumérer
+                std::unique_ptr<IRtMidiIn> in = hardwarePorts.empty()
+                                                    ? std::move(midiIn)
+                                                    : createMidiIn();
+                in->openPort(i);
+                addPort(std::move(in), portName);
                 hardwareFound = true;
-                hardwarePortIndex = i;
+                hardwarePorts.push_back(i);
                 Logger::log("[RtMidiInput] Connecté au port matériel: {}",
                             portName);
-                break;
             }
         }
 
@@ -112,11 +190,17 @@ bool RtMidiInput::initialize() {
                     break;
                 }
             }
+            // Abonnement direct au séquenceur, sans shell ni `aconnect`
+            std::unique_ptr<IMidiRouter> router;
             if (fluidSynthFound) {
-                std::string keyboardPortName =
-                    midiIn->getPortName(hardwarePortIndex);
                 Logger::log("[RtMidiInput] FluidSynth détecté sur le port: {}",
                             fluidSynthPortName);
+                router = createMidiRouter();
+            }
+            for (unsigned int hardwarePortIndex : hardwarePorts) {
+                if (!router) break;
+                std::string keyboardPortName =
+                    probe->getPortName(hardwarePortIndex);
 
                 auto getClientPort = [](const std::string& name) {
                     size_t lastSpace = name.find_last_of(' ');
@@ -131,43 +215,42 @@ bool RtMidiInput::initialize() {
 
                 std::string src = getClientPort(keyboardPortName);
                 std::string dest = getClientPort(fluidSynthPortName);
-                Logger::log("[RtMidiInput] Tentative de connexion via "
-                            "aconnect: {} -> {}",
-                            src, dest);
-
-                std::string command =
-                    "aconnect \"" + src + "\" \"" + dest + "\"";
-                int status = std::system(command.c_str());
-                if (status == 0) {
-                    Logger::log("[RtMidiInput] Connexion aconnect réussie de "
-                                "{} vers {}",
-                                src, dest);
-                } else {
-                    Logger::err(
-                        "[RtMidiInput] Échec de la commande aconnect: {}",
-                        std::to_string(status));
-                }
-            } else {
+                if (router->connect(src, dest))
+                    Logger::log("[RtMidiInput] Clavier {} routé vers {}", src,
+                                dest);
+            }
+            if (!fluidSynthFound)
                 Logger::log(
                     "[RtMidiInput] Aucun synthétiseur FluidSynth détecté");
-            }
         }
 
         if (!hardwareFound) {
             Logger::log("[RtMidiInput] Aucun clavier détecté, "
                         "ouverture d'un port virtuel");
             midiIn->openVirtualPort("input");
+            addPort(std::move(midiIn), "");
         }
 
         // Toujours ouvrir un port de sortie virtuel (optionnel, pour d'autres
         // usages)
         midiOut->openVirtualPort("output");
 
-        midiIn->ignoreTypes(true, true, true);
-
-        // Lancer thread de traitement MIDI
+        // Messages traités dès leur arrivée par RtMidi, sans scrutation
         shouldStop = false;
-        inputThread = std::thread(&RtMidiInput::processMidiMessages, this);
+        paused = false;
+        window = chordWindow.current();
+        intra = chordWindow.intraChord();
+        lateness = {};
+        late = std::chrono::microseconds(0);
+        noteWake.drain();
+        chordWake.drain();
+        chordThread = std::thread(&RtMidiInput::finalizeChords, this);
+        for (auto& port : ports) listen(*port);
+        if (hotplugInterval > std::chrono::milliseconds(0)) {
+            scanner = createMidiIn(); // Énumération propre à la surveillance
+            watchWake.drain();
+            watchThread = std::thread(&RtMidiInput::watchPorts, this);
+        }
 
         Logger::log("[RtMidiInput] Initialisation terminée avec succès");
         return true;
@@ -180,6 +263,121 @@ bool RtMidiInput::initialize() {
     }
 }
 
+void RtMidiInput::addPort(std::unique_ptr<IRtMidiIn> in,
+                          const std::string& name) {
+    auto port = std::make_unique<MidiPort>();
+    port->name = name;
+    // Index RtMidi décalés et réutilisés au rebranchement: jamais exposés
+    port->device = name.empty() ? VIRTUAL_DEVICE : nextDevice++;
+    port->in = std::move(in);
+    std::lock_guard<std::mutex> lock(portsMutex);
+    ports.push_back(std::move(port));
+}
+
+void RtMidiInput::listen(MidiPort& port) {
+    port.in->ignoreTypes(true, true, true);
+    port.in->setCallback([this, &port](double delta,
+                                       std::vector<unsigned char>* msg) {
+        // COUVERTURE: Exception ne doit pas remonter dans le thread RtMidi
+        try {
+            if (msg) onMidiMessage(port, delta, *msg);
+        } catch (const std::exception& e) {
+            Logger::err("[RtMidiInput] Exception: {}", e.what());
+        }
+    });
+}
+
+bool RtMidiInput::isHardwarePort(const std::string& name) {
+    // On cherche un clavier (ex: "reface CP", "USB MIDI", etc.)
+    // On évite de se connecter à soi-même, "Midi Through", ou "FluidSynth"
+    return name.find("SmartPianoEngine") == std::string::npos &&
+           name.find("Through") == std::string::npos &&
+           name.find("FluidSynth") == std::string::npos &&
+           name.find("fluidsynth") == std::string::npos &&
+           name.find("FLUID Synth") == std::string::npos;
+}
+
+void RtMidiInput::watchPorts() {
+    Logger::log("[RtMidiInput] Surveillance des ports démarrée ({} ms)",
+                std::to_string(hotplugInterval.count()));
+    while (!shouldStop) {
+        pollfd pfd{watchWake.fd(), POLLIN, 0};
+        poll(&pfd, 1, static_cast<int>(hotplugInterval.count()));
+        watchWake.drain();
+        if (shouldStop) break;
+        try {
+            rescanPorts();
+        } catch (RtMidiError& error) { // Port disparu pendant son ouverture
+            Logger::err("[RtMidiInput] Erreur surveillance des ports: {}",
+                        error.getMessage());
+        }
+    }
+}
+
+void RtMidiInput::rescanPorts() {
+    // Ports identifiés par leur nom: les index changent au rebranchement
+    std::vector<std::pair<std::string, unsigned int>> present;
+    unsigned int nPorts = scanner->getPortCount();
+    for (unsigned int i = 0; i < nPorts; i++) {
+        std::string name = scanner->getPortName(i);
+        if (isHardwarePort(name)) present.emplace_back(name, i);
+    }
+    auto isPresent = [&](const std::string& name) {
+        return std::ranges::any_of(
+            present, [&](const auto& p) { return p.first == name; });
+    };
+    auto isOpen = [&](const std::string& name) {
+        return std::ranges::any_of(
+            ports, [&](const auto& port) { return port->name == name; });
+    };
+    // Seule la surveillance modifie ports: lecture ici sans verrou.
+    // Ouverture avant fermeture: jamais sans port d'entrée (isReady())
+    size_t hardware = std::ranges::count_if(ports, [&](const auto& port) {
+        return !port->name.empty() && isPresent(port->name);
+    });
+    for (const auto& [name, index] : present) {
+        if (isOpen(name)) continue;
+        if (maxPorts != 0 && hardware >= maxPorts) break;
+        std::unique_ptr<IRtMidiIn> in = createMidiIn();
+        in->openPort(index);
+        addPort(std::move(in), name);
+        listen(*ports.back());
+        hardware++;
+        Logger::log("[RtMidiInput] Port branché: {}", name);
+        notifyDevice(*ports.back(), true);
+    }
+    if (hardware == 0 && !isOpen("")) { // Plus aucun clavier
+        Logger::log("[RtMidiInput] Aucun clavier, ouverture d'un port virtuel");
+        std::unique_ptr<IRtMidiIn> in = createMidiIn();
+        in->openVirtualPort("input");
+        addPort(std::move(in), "");
+        listen(*ports.back());
+    }
+    std::vector<std::unique_ptr<MidiPort>> removed;
+    {
+        std::lock_guard<std::mutex> lock(portsMutex);
+        // Ports conservés en tête, ports à fermer en fin (ordre préservé)
+        auto gone = std::ranges::stable_partition(ports, [&](const auto& p) {
+            return p->name.empty() ? hardware == 0 : isPresent(p->name);
+        });
+        for (auto& port : gone) removed.push_back(std::move(port));
+        ports.erase(gone.begin(), gone.end());
+    }
+    noteWake.notify(); // Nouveaux ports lus dès maintenant
+    for (auto& port : removed) { // Fermés hors verrou, minuteur non bloqué
+        port->in->cancelCallback();
+        retiredDrops += port->queue.overflowCount();
+        if (port->name.empty()) continue;
+        Logger::log("[RtMidiInput] Port débranché: {}", port->name);
+        notifyDevice(*port, false);
+    }
+}
+
+void RtMidiInput::notifyDevice(const MidiPort& port, bool connected) {
+    std::lock_guard<std::mutex> lock(listenerMutex);
+    if (deviceListener) deviceListener(port.name, port.device, connected);
+}
+
 std::unique_ptr<IRtMidiIn> RtMidiInput::createMidiIn() {
     return std::make_unique<RtMidiInImpl>();
 }
@@ -188,99 +386,243 @@ std::unique_ptr<IRtMidiOut> RtMidiInput::createMidiOut() {
     return std::make_unique<RtMidiOutImpl>();
 }
 
+std::unique_ptr<IMidiRouter> RtMidiInput::createMidiRouter() {
+    return std::make_unique<AlsaMidiRouter>();
+}
+
 std::vector<Note> RtMidiInput::readNotes() {
-    // Attendre que des notes soient disponibles
-    while (!notesAvailable.load()) {
-        if (shouldStop) return {}; // Sortir si arrêt demandé
-        // COUVERTURE: Nécessite d’attendre dans tests mockés
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    }
-    std::vector<Note> notes;
-    {
-        std::lock_guard<std::mutex> lock(notesMutex);
-        notes = lastNotes;
-        lastNotes.clear();
-        notesAvailable = false;
+    std::optional<std::vector<Note>> notes;
+    while (!(notes = readNotes(std::chrono::hours(1))))
+        if (isStopped()) return {}; // Fermée
+    return std::move(*notes);
+}
+
+std::optional<std::vector<NoteEvent>>
+RtMidiInput::readEvents(std::chrono::milliseconds timeout) {
+    using namespace std::chrono;
+    auto deadline = steady_clock::now() + timeout;
+    // Attendre qu'un accord soit finalisé (réveil par le minuteur ou close())
+    while (chordQueue.empty() || paused) {
+        if (shouldStop || paused) return std::nullopt; // isStopped()
+        auto left = ceil<milliseconds>(deadline - steady_clock::now());
+        if (left <= milliseconds(0)) return std::nullopt;
+        pollfd pfd{chordWake.fd(), POLLIN, 0};
+        poll(&pfd, 1, static_cast<int>(left.count()));
+        chordWake.drain();
     }
-    return notes;
+    return chordQueue.tryPop();
+}
+
+bool RtMidiInput::hasNotes() const { return !chordQueue.empty(); }
+
+void RtMidiInput::pause() {
+    Logger::log("[RtMidiInput] Lecture suspendue");
+    paused = true;
+    chordWake.notify(); // Débloque un readEvents() en attente
 }
 
-bool RtMidiInput::hasNotes() const { return notesAvailable.load(); }
+void RtMidiInput::resume() {
+    // Seul lecteur de chordQueue: accords joués entre deux parties écartés
+    while (chordQueue.tryPop()) {}
+    chordWake.drain();
+    paused = false;
+    Logger::log("[RtMidiInput] Lecture reprise");
+}
 
 void RtMidiInput::close() {
     Logger::log("[RtMidiInput] Fermeture des ressources");
 
-    // Arrêter le thread
+    // Plus aucun branchement ni message de RtMidi, puis arrêt du minuteur
     shouldStop = true;
-    if (inputThread.joinable()) {
-        inputThread.join();
+    watchWake.notify();
+    if (watchThread.joinable()) {
+        watchThread.join();
+    }
+    for (auto& port : ports) port->in->cancelCallback();
+    noteWake.notify();
+    chordWake.notify(); // Débloque un readEvents() en attente
+    if (chordThread.joinable()) {
+        chordThread.join();
     }
+    currentNotes.clear(); // Accord inachevé abandonné
+    chordKeys.clear();
+    heldKeys.clear();
+    staleKeys.clear();
+    MidiInputStats stats = getStats();
+    Logger::log("[RtMidiInput] {} accord(s), fenêtre {} µs (attaques {} µs)",
+                std::to_string(stats.chords),
+                std::to_string(stats.chordWindow.count()),
+                std::to_string(stats.intraChord.count()));
+    if (lateness.count() > 0)
+        Logger::log("[RtMidiInput] Retard du minuteur: {}", lateness.summary());
+    if (droppedCount() > 0)
+        Logger::err("[RtMidiInput] {} note(s) ou accord(s) perdu(s), "
+                    "files pleines",
+                    std::to_string(droppedCount()));
 
-    midiIn.reset();
+    {
+        std::lock_guard<std::mutex> lock(portsMutex);
+        ports.clear();
+    }
+    scanner.reset();
     midiOut.reset();
 }
 
+MidiInputStats RtMidiInput::getStats() const {
+    return {.chords = chords,
+            .dropped = droppedCount(),
+            .chordWindow = window,
+            .intraChord = intra,
+            .timerLate = late};
+}
+
 bool RtMidiInput::isReady() const {
-    return midiIn != nullptr && midiOut != nullptr;
+    std::lock_guard<std::mutex> lock(portsMutex);
+    return !ports.empty() && midiOut != nullptr;
+}
+
+void RtMidiInput::onMidiMessage(MidiPort& port, double deltaTime,
+                                const std::vector<unsigned char>& message) {
+    using namespace std::chrono;
+    // Horloge du périphérique (écarts entre messages fournis par RtMidi),
+    // recalée sur l'horloge locale si elle dérive ou après un silence
+    auto now = steady_clock::now();
+    port.time += duration_cast<steady_clock::duration>(
+        duration<double>(std::max(0.0, deltaTime)));
+    if (port.time > now || now - port.time > MAX_SKEW) port.time = now;
+    if (message.size() < 3) return;
+    int status = message[0] & 0xF0;
+    if (status != 0x90 && status != 0x80) return;
+    // Note On de vélocité nulle équivaut à Note Off
+    auto velocity =
+        static_cast<uint8_t>(status == 0x90 ? message[2] & 0x7F : 0);
+    auto key = static_cast<uint8_t>(message[1] & 0x7F);
+    // Sans verrou: le thread RtMidi ne doit jamais attendre le minuteur
+    if (!port.queue.tryPush({key, velocity, port.device, port.time})) {
+        Logger::err("[RtMidiInput] File de notes pleine, touche {} perdue",
+                    std::to_string(key));
+        return;
+    }
+    noteWake.notify();
 }
 
-void RtMidiInput::processMidiMessages() {
+void RtMidiInput::finalizeChords() {
+    using namespace std::chrono;
     Logger::log("[RtMidiInput] Thread MIDI démarré");
-    constexpr int CHORD_TIMEOUT_MS = 100; // Timeout pour accumulation d'accord
-    std::vector<unsigned char> message;
-    std::vector<Note> currentNotes;
-    auto lastNoteTime = std::chrono::steady_clock::now();
-    bool chordInProgress = false;
-    while (!shouldStop && midiIn) {
-        try {
-            midiIn->getMessage(&message);
-            if (!message.empty() && message.size() >= 3) {
-                int status = message[0] & 0xF0;
-                int midiNote = message[1];
-                int velocity = message[2];
-                // Note On avec vélocité > 0
-                if (status == 0x90 && velocity > 0) {
-                    Note note = convertMidiToNote(midiNote);
-                    currentNotes.push_back(note);
-                    lastNoteTime = std::chrono::steady_clock::now();
-                    chordInProgress = true;
-                    Logger::log("[RtMidiInput] Note reçue: {}",
-                                note.toString());
-                }
-            }
-            // Vérifier le timeout pour finaliser l'accord
-            if (chordInProgress) {
-                auto now = std::chrono::steady_clock::now();
-                auto elapsed =
-                    std::chrono::duration_cast<std::chrono::milliseconds>(
-                        now - lastNoteTime)
-                        .count();
-                if (elapsed >= CHORD_TIMEOUT_MS && !currentNotes.empty()) {
-                    // Timeout expiré - finaliser l'accord
-                    {
-                        std::lock_guard<std::mutex> lock(notesMutex);
-                        lastNotes = currentNotes;
-                        notesAvailable = true;
-                    }
-                    currentNotes.clear();
-                    chordInProgress = false;
-                    Logger::log("[RtMidiInput] Accord finalisé ({})",
-                                std::to_string(lastNotes.size()));
-                }
-            }
-        } catch (const std::exception& e) {
-            Logger::err("[RtMidiInput] Exception: {}", e.what());
+    applyRealtimePolicy(realtime, "RtMidiInput");
+    while (!shouldStop) {
+        // Endormi sans accord en cours, sinon jusqu'à son échéance
+        int timeout = -1;
+        if (!currentNotes.empty() && chordMode != ChordMode::Release) {
+            auto left = ceil<milliseconds>(chordDeadline - steady_clock::now());
+            timeout = static_cast<int>(std::max<int64_t>(0, left.count()));
+        }
+        pollfd pfd{noteWake.fd(), POLLIN, 0};
+        if (poll(&pfd, 1, timeout) == 0 && timeout >= 0) {
+            // Réveil à l'échéance: gigue de l'ordonnanceur (et arrondi ms)
+            lateness.record(steady_clock::now() - chordDeadline);
+            late = microseconds(lateness.percentileUs(99));
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        noteWake.drain();
+        // Ports fusionnés en un seul flux chronologique (chacun déjà ordonné)
+        {
+            std::lock_guard<std::mutex> lock(portsMutex);
+            for (auto& port : ports)
+                while (auto event = port->queue.tryPop())
+                    merged.push_back(*event);
+        }
+        std::stable_sort(merged.begin(), merged.end(),
+                         [](const KeyEvent& a, const KeyEvent& b) {
+                             return a.time < b.time;
+                         });
+        for (const KeyEvent& event : merged) onKey(event);
+        merged.clear();
+        if (shouldStop || currentNotes.empty() || !chordReady())
+            continue; // Réveil par une nouvelle note ou arrêt
+        size_t size = currentNotes.size();
+        if (paused) {
+            Logger::log("[RtMidiInput] Accord ignoré en pause ({})",
+                        std::to_string(size));
+        } else if (!chordQueue.tryPush(std::move(currentNotes))) {
+            Logger::err("[RtMidiInput] File d'accords pleine, accord perdu");
+        } else {
+            chords++;
+            chordWake.notify();
+            Logger::log("[RtMidiInput] Accord finalisé ({}, fenêtre {} ms)",
+                        std::to_string(size),
+                        std::to_string(duration_cast<milliseconds>(
+                                           chordWindow.current())
+                                           .count()));
+        }
+        currentNotes.clear();
+        chordKeys.clear();
+        staleKeys = heldKeys; // Seules les touches enfoncées après comptent
+    }
+}
+
+void RtMidiInput::onKey(const KeyEvent& event) {
+    using namespace std::chrono;
+    if (event.velocity == 0) {
+        heldKeys.release(event.key);
+        staleKeys.release(event.key);
+        // Touches tenues modifiées: stabilité à nouveau attendue
+        if (chordMode == ChordMode::Stable)
+            chordDeadline = event.time + stableFor;
+        return;
+    }
+    if (!MIDI_NOTE_NAMES[event.key].playable()) { // Hors des octaves 0 à 8
+        Logger::err("[RtMidiInput] Touche {} ignorée",
+                    MIDI_NOTE_NAMES[event.key].str());
+        return;
     }
+    heldKeys.press(event.key);
+    staleKeys.release(event.key); // Touche rejouée: attaque nouvelle
+    // Fenêtre apprise des intervalles entre attaques du joueur
+    if (lastOnset != steady_clock::time_point{})
+        chordWindow.observe(
+            duration_cast<microseconds>(event.time - lastOnset));
+    lastOnset = event.time;
+    window = chordWindow.current();
+    intra = chordWindow.intraChord();
+    NoteEvent& note = pressed[event.key];
+    note = {.midi = event.key,
+            .velocity = event.velocity,
+            .device = event.device,
+            .note = midiToNote(event.key),
+            .time = event.time};
+    Logger::log("[RtMidiInput] Note reçue: {} ({})",
+                MIDI_NOTE_NAMES[event.key].str(),
+                std::to_string(note.velocity));
+    if (chordMode == ChordMode::Window) {
+        // Chaque note de l'accord repousse son échéance
+        currentNotes.push_back(note);
+        chordDeadline = event.time + chordWindow.current();
+        return;
+    }
+    chordDeadline = event.time + stableFor;
+    // Accord: plus grand ensemble de touches tenues simultanément, hors
+    // touches encore tenues depuis l'accord précédent
+    HeldKeys fresh = heldKeys.without(staleKeys);
+    if (fresh.count() > chordKeys.count()) {
+        chordKeys = fresh;
+        currentNotes.clear();
+        for (uint8_t key : chordKeys.keys())
+            currentNotes.push_back(pressed[key]);
+    }
+}
+
+bool RtMidiInput::chordReady() const {
+    if (chordComplete()) return true;
+    if (chordMode != ChordMode::Window && heldKeys.without(staleKeys).empty())
+        return true;
+    return chordMode != ChordMode::Release &&
+           std::chrono::steady_clock::now() >= chordDeadline;
 }
 
-Note RtMidiInput::convertMidiToNote(int midiNote) const {
-    static const std::map<int, std::string> noteNames = {
-        {0, "c"},  {1, "c#"}, {2, "d"},  {3, "d#"}, {4, "e"},   {5, "f"},
-        {6, "f#"}, {7, "g"},  {8, "g#"}, {9, "a"},  {10, "a#"}, {11, "b"}};
-    int octave = (midiNote / 12) - 1;
-    int noteIndex = midiNote % 12;
-    auto it = noteNames.find(noteIndex);
-    return Note(it->second, octave);
+bool RtMidiInput::chordComplete() const {
+    size_t expected = expectedNotes;
+    if (expected == 0) return false;
+    HeldKeys distinct; // Note répétée (rebond de touche) comptée une fois
+    for (const NoteEvent& event : currentNotes) distinct.press(event.midi);
+    return distinct.count() >= expected;
 }
@@ -0,0 +1,147 @@
+#include "SyntheticMidiInput.hpp"
+#include "Logger.hpp"
+#include "MidiNotes.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+SyntheticMidiInput::SyntheticMidiInput(PerformerModel performer,
+                                       double playbackSpeed)
+    : model(performer), speed(std::max(0.0, playbackSpeed)),
+      random(performer.seed != 0 ? performer.seed : std::random_device{}()) {
+    Logger::log("[SyntheticMidiInput] Instance créée");
+}
+
+bool SyntheticMidiInput::initialize() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    this->answer.reset();
+    this->paused = false;
+    this->ready = true;
+    Logger::log("[SyntheticMidiInput] Joueur simulé prêt (réaction {} ms, "
+                "erreurs {}%)",
+                std::to_string(this->model.reaction.count()),
+                std::to_string(static_cast<int>(this->model.errorRate * 100)));
+    return true;
+}
+
+void SyntheticMidiInput::onChallenge(const Message& msg) {
+    if (msg.getType() != "note" && msg.getType() != "chord") return;
+    auto shown = std::chrono::steady_clock::now();
+    std::istringstream stream(msg.getType() == "note" ? msg.getField("note")
+                                                      : msg.getField("notes"));
+    std::vector<Note> expected;
+    std::string token;
+    try {
+        while (stream >> token) expected.emplace_back(token);
+    } catch (const std::invalid_argument& e) {
+        Logger::err("[SyntheticMidiInput] Challenge ignoré: {}", e.what());
+        return;
+    }
+    if (expected.empty()) return;
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (!this->ready || this->paused) return;
+    perform(expected, shown);
+    this->challenges++;
+    this->cv.notify_all();
+}
+
+void SyntheticMidiInput::perform(const std::vector<Note>& expected,
+                                 std::chrono::steady_clock::time_point shown) {
+    using namespace std::chrono;
+    // Réaction log-normale autour de la médiane, accord plaqué plus ou
+    // moins arpégé: chaque note décalée dans l'étalement
+    std::lognormal_distribution<double> reaction(
+        std::log(std::max<double>(1, this->model.reaction.count())),
+        this->model.reactionSpread);
+    std::uniform_real_distribution<double> roll(
+        0, static_cast<double>(this->model.rollSpread.count()));
+    double first = reaction(this->random);
+    std::vector<NoteEvent> events;
+    for (const Note& note : expected) {
+        duration<double, std::milli> offset(first + roll(this->random));
+        // Sans attente: instants fictifs, durées mesurées par le jeu exactes
+        if (this->speed > 0) offset /= this->speed;
+        auto [midi, played] = play(note);
+        events.push_back({.midi = midi,
+                          .velocity = 100,
+                          .note = played,
+                          .time = shown + duration_cast<nanoseconds>(offset)});
+    }
+    std::ranges::sort(events, {}, &NoteEvent::time);
+    this->due = this->speed > 0 ? events.back().time : shown;
+    this->answer = std::move(events); // Challenge précédent sans réponse lue
+}
+
+std::pair<uint8_t, Note> SyntheticMidiInput::play(const Note& expected) {
+    std::bernoulli_distribution wrongNote(this->model.errorRate);
+    std::bernoulli_distribution wrongOctave(this->model.wrongOctaveRate);
+    std::bernoulli_distribution up(0.5);
+    int midi = expected.toMidi();
+    int played = midi;
+    if (wrongNote(this->random)) // Touche voisine, à un ou deux demi-tons
+        played += (up(this->random) ? 1 : -1) *
+                  std::uniform_int_distribution<int>(1, 2)(this->random);
+    if (wrongOctave(this->random))
+        played += up(this->random) ? 12 : -12;
+    if (played == midi || played < 0 || played > 127 ||
+        !MIDI_NOTE_NAMES[played].playable())
+        return {static_cast<uint8_t>(midi), expected};
+    this->mistakes++;
+    auto key = static_cast<uint8_t>(played);
+    return {key, midiToNote(key)};
+}
+
+std::vector<Note> SyntheticMidiInput::readNotes() {
+    std::optional<std::vector<Note>> notes;
+    while (!(notes = readNotes(std::chrono::hours(1))))
+        if (isStopped()) return {}; // Fermée
+    return std::move(*notes);
+}
+
+std::optional<std::vector<NoteEvent>>
+SyntheticMidiInput::readEvents(std::chrono::milliseconds timeout) {
+    using namespace std::chrono;
+    auto deadline = steady_clock::now() + timeout;
+    std::unique_lock<std::mutex> lock(this->mtx);
+    while (this->ready && !this->paused) {
+        auto now = steady_clock::now();
+        if (this->answer && this->due <= now) {
+            std::vector<NoteEvent> events = std::move(*this->answer);
+            this->answer.reset();
+            return events;
+        }
+        if (now >= deadline) return std::nullopt;
+        this->cv.wait_until(
+            lock, this->answer ? std::min(this->due, deadline) : deadline);
+    }
+    return std::nullopt; // Fermée ou en pause: isStopped()
+}
+
+bool SyntheticMidiInput::hasNotes() const {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    return this->answer && this->due <= std::chrono::steady_clock::now();
+}
+
+void SyntheticMidiInput::pause() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    this->paused = true;
+    this->answer.reset(); // Challenge abandonné avec la partie
+    this->cv.notify_all(); // Débloque un readEvents() en attente
+}
+
+void SyntheticMidiInput::resume() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    this->paused = false;
+    this->answer.reset();
+}
+
+void SyntheticMidiInput::close() {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (!this->ready) return;
+    this->ready = false;
+    this->cv.notify_all(); // Débloque un readEvents() en attente
+    Logger::log("[SyntheticMidiInput] {} challenge(s), {} note(s) fausse(s)",
+                std::to_string(this->challenges),
+                std::to_string(this->mistakes));
+}
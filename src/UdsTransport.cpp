@@ -1,55 +1,241 @@
 #include "UdsTransport.hpp"
 #include "Logger.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
 #include <cstring>
+#include <fcntl.h>
 #include <poll.h>
 #include <sstream>
 #include <string>
+#include <sys/uio.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <unistd.h>
+#include <utility>
 
 bool UdsTransport::hasMessage() const {
-    if (this->clientSock < 0) return false;
-    struct pollfd pfd;
-    pfd.fd = this->clientSock;
-    pfd.events = POLLIN;
-    int ret = poll(&pfd, 1, 0);
-    return ret > 0 && (pfd.revents & POLLIN);
+    std::lock_guard<std::mutex> lock(this->inboxMutex);
+    return !this->inbox.empty();
 }
 
 bool UdsTransport::start() {
-    unlink(this->sockPath.c_str()); // Supprimer socket existant s'il existe
+    if (this->inheritedSock >= 0) { // Activation par socket, déjà en écoute
+        int fd = std::exchange(this->inheritedSock, -1);
+        if (!prepareInherited(fd)) {
+            close(fd);
+            return false;
+        }
+        this->serverSock = fd;
+        this->inherited = true;
+    } else {
+        this->serverSock = listenOn(this->sockPath);
+        if (this->serverSock < 0) return false;
+        this->inherited = false;
+    }
+    // Réveils d'un éventuel arrêt précédent
+    this->acceptWake.drain();
+    this->wake.drain();
+    Logger::log("[UdsTransport] Serveur démarré sur {}{}", this->sockPath,
+                this->inherited ? " (socket héritée)" : "");
+    // Observateurs optionnels: leur échec n'empêche pas de jouer
+    if (!this->watchPath.empty() && !this->watching) {
+        this->watchSock = listenOn(this->watchPath);
+        if (this->watchSock >= 0) {
+            this->watchWake.drain();
+            this->watching = true;
+            this->watchThread = std::thread(&UdsTransport::watchLoop, this);
+            Logger::log("[UdsTransport] Observateurs acceptés sur {}",
+                        this->watchPath);
+        }
+    }
+    // Mise à jour à chaud optionnelle: une nouvelle instance peut prendre le
+    // relais (la socket de contrôle de l'ancienne est alors remplacée)
+    this->handedOff = false;
+    if (!this->handoffPath.empty() && this->handoffSock < 0) {
+        this->handoffSock = listenOn(this->handoffPath);
+        if (this->handoffSock >= 0) {
+            this->handoffWake.drain();
+            this->handoffThread = std::thread(&UdsTransport::handoffLoop, this);
+            Logger::log("[UdsTransport] Relève acceptée sur {}",
+                        this->handoffPath);
+        }
+    }
+    return true;
+}
+
+bool UdsTransport::takeOver(const std::string& path) {
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0) {
+        Logger::err("[UdsTransport] Erreur: Impossible de créer le socket");
+        return false;
+    }
+    fcntl(sock, F_SETFD, FD_CLOEXEC);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    timeval timeout{2, 0}; // Ancienne instance bloquée: démarrage normal
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    int listener = -1;
+    if (connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0)
+        listener = receiveFd(sock);
+    if (listener < 0) {
+        Logger::err("[UdsTransport] Erreur: Aucune instance à relever sur {}",
+                    path);
+        close(sock);
+        return false;
+    }
+    this->inheritedSock = listener;
+    this->predecessorSock = sock; // Clients inactifs cédés plus tard
+    Logger::log("[UdsTransport] Socket d'écoute reprise de {}", path);
+    return true;
+}
+
+void UdsTransport::handoffLoop() {
+    pollfd fds[2] = {{this->handoffSock, POLLIN, 0},
+                     {this->handoffWake.fd(), POLLIN, 0}};
+    while (true) {
+        if (poll(fds, 2, -1) < 0) continue; // EINTR
+        if (fds[1].revents) return;         // stop()
+        int conn = accept(this->handoffSock, nullptr, nullptr);
+        if (conn < 0) continue;
+        fcntl(conn, F_SETFD, FD_CLOEXEC);
+        if (!sendFd(conn, this->serverSock)) {
+            Logger::err("[UdsTransport] Erreur: Échec de la relève");
+            close(conn);
+            continue;
+        }
+        // Plus aucun accept() ici: les connexions vont à la nouvelle instance
+        this->successorSock = conn;
+        this->handedOff = true;
+        this->acceptWake.notify();
+        Logger::log("[UdsTransport] Socket d'écoute cédée à la relève");
+        if (this->onHandoff) this->onHandoff();
+        return; // Une seule relève par instance
+    }
+}
+
+bool UdsTransport::handOffClient() {
+    if (!this->handedOff || this->clientSock < 0) return false;
+    {
+        // Tout message déjà émis doit être écrit avant de céder la socket
+        std::unique_lock<std::mutex> lock(this->sendMutex);
+        this->outboxCv.wait_for(lock, this->policy.drainTimeout, [this] {
+            return this->outbox.empty() || this->clientSock < 0;
+        });
+    }
+    // Arrête le thread I/O sans fermer la socket ni toucher à la connexion
+    this->detaching = true;
+    this->wake.notify();
+    if (this->ioThread.joinable()) this->ioThread.join();
+    this->detaching = false;
+    int fd = std::exchange(this->detachedFd, -1);
+    if (fd < 0) return false; // Déconnecté entre-temps
+    // Message reçu mais non traité: perdu pour la relève, le client se
+    // reconnectera plutôt que de rester bloqué
+    bool idle = this->rxBuffer.empty() && !hasMessage();
+    bool sent = idle && sendFd(this->successorSock, fd);
+    close(fd);
+    Logger::log("[UdsTransport] Client {} la relève",
+                sent ? "cédé à" : "déconnecté pour");
+    return sent;
+}
+
+bool UdsTransport::sendFd(int sock, int fd) {
+    char tag = 'F'; // Au moins un octet de données avec SCM_RIGHTS
+    iovec iov{&tag, 1};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    return sendmsg(sock, &msg, MSG_NOSIGNAL) == 1;
+}
+
+int UdsTransport::receiveFd(int sock) {
+    char tag;
+    iovec iov{&tag, 1};
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(sock, &msg, 0) <= 0) return -1;
+    cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (!cmsg || cmsg->cmsg_level != SOL_SOCKET ||
+        cmsg->cmsg_type != SCM_RIGHTS)
+        return -1;
+    int fd;
+    memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    return fd;
+}
+
+int UdsTransport::listenFdFromEnv() {
+    constexpr int firstFd = 3; // SD_LISTEN_FDS_START
+    const char* pid = std::getenv("LISTEN_PID");
+    const char* fds = std::getenv("LISTEN_FDS");
+    // Variables destinées à ce processus seulement (pas à un parent)
+    bool forUs = pid && fds && std::atol(pid) == getpid() && std::atoi(fds) > 0;
+    unsetenv("LISTEN_PID");
+    unsetenv("LISTEN_FDS");
+    unsetenv("LISTEN_FDNAMES");
+    return forUs ? firstFd : -1;
+}
+
+bool UdsTransport::prepareInherited(int fd) {
+    int listening = 0;
+    socklen_t len = sizeof(listening);
+    if (getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &listening, &len) < 0 ||
+        !listening) {
+        Logger::err("[UdsTransport] Erreur: Descripteur {} hérité n'est pas "
+                    "une socket en écoute",
+                    fd);
+        return false;
+    }
+    // accept() bloquant, et socket non transmise aux commandes lancées
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    return true;
+}
+
+int UdsTransport::listenOn(const std::string& path) {
+    unlink(path.c_str()); // Supprimer socket existant s'il existe
     // Créer socket Unix
-    this->serverSock = socket(AF_UNIX, SOCK_STREAM, 0);
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
     // COUVERTURE: Qu’en cas d’erreur noyau, épuisement descripteurs fichiers…
-    if (this->serverSock < 0) {
+    if (sock < 0) {
         Logger::err("[UdsTransport] Erreur: Impossible de créer le socket");
-        return false;
+        return -1;
     }
     // Configurer l'adresse du socket
     struct sockaddr_un addr;
     memset(&addr, 0, sizeof(addr));
     addr.sun_family = AF_UNIX;
-    strncpy(addr.sun_path, this->sockPath.c_str(), sizeof(addr.sun_path) - 1);
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
     // Lier le socket
-    if (bind(this->serverSock, reinterpret_cast<sockaddr*>(&addr),
-             sizeof(addr)) < 0) {
+    if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
         Logger::err("[UdsTransport] Erreur: Impossible de lier le socket");
-        close(this->serverSock);
-        this->serverSock = -1;
-        return false;
+        close(sock);
+        return -1;
     }
     // Écouter les connexions
     // COUVERTURE: Qu’en cas de socket invalide, permissions NOK…
-    if (listen(this->serverSock, 1) < 0) {
+    if (listen(sock, 1) < 0) {
         Logger::err(
             "[UdsTransport] Erreur: Impossible de mettre le socket en écoute");
-        close(this->serverSock);
-        this->serverSock = -1;
-        return false;
+        close(sock);
+        return -1;
     }
-    Logger::log("[UdsTransport] Serveur démarré sur {}", this->sockPath);
-    return true;
+    return sock;
 }
 
 void UdsTransport::waitForClient() {
@@ -57,101 +243,513 @@ void UdsTransport::waitForClient() {
         Logger::err("[UdsTransport] Erreur: Serveur non initialisé");
         return;
     }
-    this->clientSock = accept(this->serverSock, nullptr, nullptr);
-    // COUVERTURE: Qu’en cas de socket invalide, serveur mal initialisé…
-    if (this->clientSock < 0) {
-        Logger::err(
-            "[UdsTransport] Erreur: Échec de l'acceptation de connexion");
-        return;
+    if (this->handedOff) return; // Nouvelles connexions pour la relève
+    // Libérer le thread de lecture d'un éventuel client précédent
+    if (this->ioThread.joinable()) this->ioThread.join();
+    int fd = -1;
+    while (fd < 0) {
+        // Nouvelle connexion, ou client inactif cédé par l'ancienne instance
+        pollfd fds[3] = {{this->serverSock, POLLIN, 0},
+                         {this->acceptWake.fd(), POLLIN, 0},
+                         {this->predecessorSock, POLLIN, 0}};
+        if (poll(fds, 3, -1) < 0 && errno == EINTR) continue;
+        if (fds[1].revents) return; // stop() ou relève
+        if (fds[2].revents) {
+            fd = receiveFd(this->predecessorSock);
+            if (fd < 0) { // Ancienne instance terminée
+                close(this->predecessorSock);
+                this->predecessorSock = -1;
+            }
+            continue;
+        }
+        fd = accept(this->serverSock, nullptr, nullptr);
+        // COUVERTURE: Qu’en cas de socket invalide, serveur mal initialisé…
+        if (fd < 0) {
+            Logger::err(
+                "[UdsTransport] Erreur: Échec de l'acceptation de connexion");
+            return;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->inboxMutex);
+        this->inbox.clear();
+        this->connected = true;
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->statsMutex);
+        this->stats = TransportStats{};
     }
+    this->rxBuffer.clear();
+    this->awaitingPong = false;
+    this->missedHeartbeats = 0;
+    this->clientSock = fd;
+    this->ioThread = std::thread(&UdsTransport::ioLoop, this, fd);
     Logger::log("[UdsTransport] Client connecté");
 }
 
 void UdsTransport::send(const Message& msg) {
+    std::lock_guard<std::mutex> lock(this->sendMutex);
     if (this->clientSock < 0) {
         Logger::err("[UdsTransport] Erreur: Aucun client connecté");
         return;
     }
-
-    std::string data = serializeMessage(msg);
-    ssize_t sent =
-        ::send(this->clientSock, data.c_str(), data.length(), MSG_NOSIGNAL);
-
-    if (sent < 0) {
+    auto frame = std::make_shared<const std::string>(serializeMessage(msg));
+    enqueue(msg, frame);
+    // Battements de cœur propres à chaque connexion, jamais diffusés
+    if (this->watching && msg.getType() != "ping" && msg.getType() != "pong")
+        broadcast(frame);
+    // Écriture immédiate si la socket l'accepte, le reste attend POLLOUT
+    if (!flushOutbox(this->clientSock)) {
         Logger::err("[UdsTransport] Erreur: Échec de l'envoi du message");
         return;
     }
+    if (!this->outbox.empty()) this->wake.notify();
     Logger::debug("[UdsTransport] Message envoyé: type={}", msg.getType());
 }
 
+void UdsTransport::enqueue(const Message& msg, const Frame& frame) {
+    bool informational = isInformational(msg.getType());
+    std::string id = msg.getField("id");
+    // Le premier message, s'il est entamé, doit être écrit en entier
+    auto first = this->outbox.begin() + (this->outOffset > 0 ? 1 : 0);
+    std::lock_guard<std::mutex> lock(this->statsMutex);
+    if (informational && this->policy.coalesce) {
+        auto same = std::find_if(first, this->outbox.end(), [&](auto& f) {
+            return f.informational && f.type == msg.getType() && f.id == id;
+        });
+        if (same != this->outbox.end()) { // Version la plus récente seulement
+            same->data = frame;
+            this->stats.coalesced++;
+            return;
+        }
+    }
+    if (this->outbox.size() >= this->policy.maxQueued) {
+        if (informational) {
+            this->stats.dropped++;
+            return;
+        }
+        // Faire de la place en délestant un message informatif en attente
+        auto victim = std::find_if(first, this->outbox.end(),
+                                   [](auto& f) { return f.informational; });
+        if (victim != this->outbox.end()) {
+            this->outbox.erase(victim);
+            this->stats.dropped++;
+        }
+    }
+    this->outbox.push_back({frame, msg.getType(), id, informational});
+    this->stats.peakQueueDepth =
+        std::max(this->stats.peakQueueDepth, this->outbox.size());
+    if (this->outbox.size() > this->policy.disconnectAfter) {
+        Logger::err("[UdsTransport] Client bloqué, {} messages en attente",
+                    this->outbox.size());
+        this->stats.overflows++;
+        shutdown(this->clientSock, SHUT_RDWR); // Fin traitée par ioLoop
+    }
+}
+
+bool UdsTransport::flushOutbox(int fd) {
+    bool ok = flushFrames(fd, this->outbox, this->outOffset);
+    if (this->outbox.empty()) this->outboxCv.notify_all();
+    return ok;
+}
+
+template <typename Queue>
+bool UdsTransport::flushFrames(int fd, Queue& frames, size_t& offset) {
+    constexpr size_t MAX_IOV = 64; // Messages regroupés par appel système
+    while (!frames.empty()) {
+        struct iovec iov[MAX_IOV];
+        size_t count = 0;
+        size_t total = 0;
+        for (auto it = frames.begin(); it != frames.end() && count < MAX_IOV;
+             ++it, ++count) {
+            const std::string& data = bytes(*it);
+            size_t skip = count == 0 ? offset : 0;
+            iov[count] = {const_cast<char*>(data.data()) + skip,
+                          data.size() - skip};
+            total += data.size() - skip;
+        }
+        struct msghdr hdr{};
+        hdr.msg_iov = iov;
+        hdr.msg_iovlen = count;
+        ssize_t sent = sendmsg(fd, &hdr, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) return errno == EAGAIN || errno == EWOULDBLOCK;
+        // Retirer les messages entièrement écrits
+        for (auto left = static_cast<size_t>(sent); left > 0;) {
+            size_t remaining = bytes(frames.front()).size() - offset;
+            if (left < remaining) {
+                offset += left;
+                break;
+            }
+            left -= remaining;
+            frames.pop_front();
+            offset = 0;
+        }
+        if (static_cast<size_t>(sent) < total) return true; // Socket pleine
+    }
+    return true;
+}
+
+void UdsTransport::broadcast(const Frame& frame) {
+    if (this->observerCount == 0) return;
+    {
+        std::lock_guard<std::mutex> lock(this->publishedMutex);
+        this->published.push_back(frame);
+    }
+    this->watchWake.notify();
+}
+
+void UdsTransport::watchLoop() {
+    char scratch[256];
+    std::vector<struct pollfd> pfds;
+    while (this->watching) {
+        pfds.assign(
+            {{this->watchSock, POLLIN, 0}, {this->watchWake.fd(), POLLIN, 0}});
+        for (const auto& observer : this->observers) {
+            short events = POLLIN;
+            if (!observer.queue.empty()) events |= POLLOUT;
+            pfds.push_back({observer.fd, events, 0});
+        }
+        if (poll(pfds.data(), pfds.size(), -1) < 0) continue; // EINTR
+        if (pfds[1].revents & POLLIN) {
+            this->watchWake.drain();
+            // Répartition hors du thread émetteur: copies de pointeurs seules
+            std::deque<Frame> batch;
+            {
+                std::lock_guard<std::mutex> lock(this->publishedMutex);
+                batch.swap(this->published);
+            }
+            for (auto& observer : this->observers)
+                observer.queue.insert(observer.queue.end(), batch.begin(),
+                                      batch.end());
+            // Tenter l'écriture sans attendre un tour de poll()
+            for (size_t i = 2; i < pfds.size(); ++i)
+                pfds[i].revents |= POLLOUT;
+        }
+        for (size_t i = 2; i < pfds.size(); ++i) {
+            Observer& observer = this->observers[i - 2];
+            bool gone = pfds[i].revents & (POLLHUP | POLLERR);
+            // Tout ce qu'envoie un observateur est ignoré (lecture seule)
+            if (pfds[i].revents & POLLIN)
+                gone |= recv(observer.fd, scratch, sizeof(scratch),
+                             MSG_DONTWAIT) == 0;
+            if (!gone && (pfds[i].revents & POLLOUT))
+                gone = !flushFrames(observer.fd, observer.queue,
+                                    observer.offset);
+            // Observateur trop lent: coupé, sans jamais freiner la session
+            if (!gone && observer.queue.size() > this->policy.disconnectAfter) {
+                Logger::err("[UdsTransport] Observateur bloqué, coupure");
+                gone = true;
+            }
+            if (gone) {
+                close(observer.fd);
+                observer.fd = -1;
+            }
+        }
+        std::erase_if(this->observers,
+                      [](const Observer& o) { return o.fd < 0; });
+        if (pfds[0].revents & POLLIN) {
+            int fd = accept(this->watchSock, nullptr, nullptr);
+            if (fd >= 0) {
+                this->observers.push_back({fd, {}, 0});
+                Logger::log("[UdsTransport] Observateur connecté ({})",
+                            this->observers.size());
+            }
+        }
+        this->observerCount = this->observers.size();
+    }
+    for (const auto& observer : this->observers) close(observer.fd);
+    this->observers.clear();
+    this->observerCount = 0;
+}
+
 Message UdsTransport::receive() {
-    if (this->clientSock < 0) {
+    std::unique_lock<std::mutex> lock(this->inboxMutex);
+    this->inboxCv.wait(
+        lock, [this] { return !this->inbox.empty() || !this->connected; });
+    return takeMessage();
+}
+
+std::optional<Message>
+UdsTransport::receive(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(this->inboxMutex);
+    if (!this->inboxCv.wait_for(lock, timeout, [this] {
+            return !this->inbox.empty() || !this->connected;
+        }))
+        return std::nullopt;
+    return takeMessage();
+}
+
+Message UdsTransport::takeMessage() {
+    if (this->inbox.empty()) {
         Logger::err("[UdsTransport] Erreur: Aucun client connecté");
         return Message("error");
     }
+    Message msg = std::move(this->inbox.front());
+    this->inbox.pop_front();
+    Logger::debug("[UdsTransport] Message reçu");
+    return msg;
+}
+
+void UdsTransport::ioLoop(int fd) {
+    using namespace std::chrono;
     char buffer[4096];
-    std::string data;
-    // Lire jusqu'à trouver double newline
+    auto nextPing = steady_clock::now() + this->heartbeatInterval;
     while (true) {
-        ssize_t received =
-            recv(this->clientSock, buffer, sizeof(buffer) - 1, 0);
-        // COUVERTURE: Échec recv() < 0 non testé…
+        // Attente de données, bornée par la prochaine échéance de `ping`
+        int timeoutMs = -1;
+        if (this->heartbeatInterval.count() > 0) {
+            auto now = steady_clock::now();
+            if (now >= nextPing) {
+                if (!heartbeat()) break;
+                nextPing = now + this->heartbeatInterval;
+            }
+            timeoutMs = static_cast<int>(
+                duration_cast<milliseconds>(nextPing - now).count());
+        }
+        short events = POLLIN;
+        {
+            std::lock_guard<std::mutex> lock(this->sendMutex);
+            if (!this->outbox.empty()) events |= POLLOUT;
+        }
+        struct pollfd pfds[2] = {{fd, events, 0},
+                                 {this->wake.fd(), POLLIN, 0}};
+        int ret = poll(pfds, 2, timeoutMs);
+        if (ret == 0 || (ret < 0 && errno == EINTR)) continue;
+        if (ret > 0 && (pfds[1].revents & POLLIN)) this->wake.drain();
+        if (this->detaching) break; // Client cédé à la relève
+        if (ret > 0 && (pfds[0].revents & POLLOUT)) {
+            std::lock_guard<std::mutex> lock(this->sendMutex);
+            if (!flushOutbox(fd)) {
+                Logger::err("[UdsTransport] Erreur: Échec de l'envoi différé");
+                break;
+            }
+        }
+        if (ret > 0 && !(pfds[0].revents & (POLLIN | POLLHUP | POLLERR)))
+            continue;
+        ssize_t received = ret > 0 ? recv(fd, buffer, sizeof(buffer), 0) : -1;
+        // COUVERTURE: Échec poll()/recv() < 0 non testé…
         if (received < 0) {
             Logger::err("[UdsTransport] Erreur: Échec de réception");
-            return Message("error");
+            break;
         }
         if (received == 0) {
             Logger::err("[UdsTransport] Client déconnecté");
-            close(this->clientSock);
-            this->clientSock = -1;
-            return Message("error");
-        }
-        buffer[received] = '\0';
-        if (std::string(buffer).find("\n") != std::string::npos)
-            Logger::debug("[UdsTransport] Ligne reçue: {}", buffer);
-        data += buffer;
-        // Vérifier si message complet (double newline)
-        if (data.find("\n\n") != std::string::npos ||
-            data.find("\r\n\r\n") != std::string::npos)
             break;
+        }
+        Logger::debug("[UdsTransport] Données reçues: {}",
+                      std::string(buffer, received));
+        this->rxBuffer.append(buffer, received);
+        dispatchFrames();
+    }
+    // Fermeture côté moteur, les messages déjà reçus restent lisibles
+    {
+        std::lock_guard<std::mutex> lock(this->sendMutex);
+        this->clientSock = -1;
+        this->outbox.clear(); // Plus personne pour les lire
+        this->outOffset = 0;
+        if (this->detaching) this->detachedFd = fd; // Ouverte pour la relève
+        else close(fd);
+    }
+    this->outboxCv.notify_all();
+    {
+        std::lock_guard<std::mutex> lock(this->inboxMutex);
+        this->connected = false;
     }
+    this->inboxCv.notify_all();
+    TransportStats last = getStats();
+    {
+        std::lock_guard<std::mutex> lock(this->statsMutex);
+        this->totals.pingsSent += last.pingsSent;
+        this->totals.pongsReceived += last.pongsReceived;
+        this->totals.missedHeartbeats += last.missedHeartbeats;
+        this->totals.rtt.merge(last.rtt);
+        this->totals.peakQueueDepth =
+            std::max(this->totals.peakQueueDepth, last.peakQueueDepth);
+        this->totals.dropped += last.dropped;
+        this->totals.coalesced += last.coalesced;
+        this->totals.overflows += last.overflows;
+    }
+    logStats("Connexion", last);
+}
 
-    Logger::debug("[UdsTransport] Message reçu");
-    return parseMessage(data);
+void UdsTransport::logStats(const std::string& scope,
+                            const TransportStats& s) {
+    Logger::log("[UdsTransport] {}: file d'envoi {} au plus, {} fusionné(s)",
+                scope, s.peakQueueDepth, s.coalesced);
+    if (s.pingsSent > 0)
+        Logger::log("[UdsTransport] {}: RTT {} ({} ping, {} manqués)", scope,
+                    s.rtt.summary(), s.pingsSent, s.missedHeartbeats);
+    if (s.dropped > 0 || s.overflows > 0)
+        Logger::err("[UdsTransport] {}: client lent, {} message(s) "
+                    "abandonné(s), {} coupure(s) pour file pleine",
+                    scope, s.dropped, s.overflows);
+}
+
+void UdsTransport::dispatchFrames() {
+    std::string frame;
+    while (extractFrame(this->rxBuffer, frame)) {
+        Message msg = parseMessage(frame);
+        if (frame.front() == '\n') // parseMessage reste sans effet de bord
+            Logger::err("[UdsTransport] Erreur: Type de message manquant");
+        if (msg.getType() == "ping") { // Réponse immédiate, même identifiant
+            send(Message("pong", msg.getFields()));
+        } else if (msg.getType() == "pong") {
+            handlePong(msg);
+        } else {
+            {
+                std::lock_guard<std::mutex> lock(this->inboxMutex);
+                this->inbox.push_back(std::move(msg));
+            }
+            this->inboxCv.notify_one();
+        }
+    }
+}
+
+bool UdsTransport::heartbeat() {
+    if (this->awaitingPong) {
+        this->missedHeartbeats++;
+        {
+            std::lock_guard<std::mutex> lock(this->statsMutex);
+            this->stats.missedHeartbeats++;
+        }
+        if (this->missedHeartbeats >= this->maxMissedHeartbeats) {
+            Logger::err("[UdsTransport] Client muet après {} ping, coupure",
+                        this->missedHeartbeats);
+            return false;
+        }
+    }
+    this->pingId++;
+    this->awaitingPong = true;
+    this->pingSentAt = std::chrono::steady_clock::now();
+    send(Message("ping", {{"id", std::to_string(this->pingId)}}));
+    std::lock_guard<std::mutex> lock(this->statsMutex);
+    this->stats.pingsSent++;
+    return true;
+}
+
+void UdsTransport::handlePong(const Message& msg) {
+    // Un `pong` tardif (ping déjà compté manqué) est ignoré
+    if (!this->awaitingPong || msg.getField("id") != std::to_string(pingId))
+        return;
+    auto rtt = std::chrono::steady_clock::now() - this->pingSentAt;
+    this->awaitingPong = false;
+    this->missedHeartbeats = 0;
+    std::lock_guard<std::mutex> lock(this->statsMutex);
+    this->stats.pongsReceived++;
+    this->stats.rtt.record(rtt);
+    Logger::debug("[UdsTransport] RTT: {} µs",
+                  std::chrono::duration_cast<std::chrono::microseconds>(rtt)
+                      .count());
+}
+
+bool UdsTransport::extractFrame(std::string& buffer, std::string& frame) {
+    // Fin de message: première ligne vide (LF ou CRLF)
+    size_t lf = buffer.find("\n\n");
+    size_t crlf = buffer.find("\n\r\n");
+    size_t end = std::min(lf == std::string::npos ? lf : lf + 2,
+                          crlf == std::string::npos ? crlf : crlf + 3);
+    if (end == std::string::npos) return false;
+    frame = buffer.substr(0, end);
+    buffer.erase(0, end);
+    return true;
+}
+
+void UdsTransport::setHeartbeat(std::chrono::milliseconds interval,
+                                uint32_t maxMissed) {
+    this->heartbeatInterval = interval;
+    this->maxMissedHeartbeats = std::max<uint32_t>(1, maxMissed);
+    Logger::log("[UdsTransport] Battement de cœur: {} ms, {} manqués max",
+                interval.count(), this->maxMissedHeartbeats);
+}
+
+TransportStats UdsTransport::getStats() const {
+    TransportStats copy;
+    {
+        std::lock_guard<std::mutex> lock(this->statsMutex);
+        copy = this->stats;
+    }
+    {
+        std::lock_guard<std::mutex> lock(this->sendMutex);
+        copy.queueDepth = this->outbox.size();
+    }
+    copy.observers = this->observerCount;
+    return copy;
+}
+
+bool UdsTransport::isInformational(const std::string& type) {
+    return type == "ping" || type == "pong" || type == "gametype";
 }
 
 void UdsTransport::stop() {
-    if (this->clientSock >= 0) {
-        shutdown(this->clientSock, SHUT_RDWR);
-        close(this->clientSock);
-        this->clientSock = -1;
+    // Laisse au client le temps de lire les derniers messages (ex. `over`)
+    {
+        std::unique_lock<std::mutex> lock(this->sendMutex);
+        this->outboxCv.wait_for(lock, this->policy.drainTimeout, [this] {
+            return this->outbox.empty() || this->clientSock < 0;
+        });
+    }
+    // Réveille le thread de lecture, qui ferme lui-même la socket client
+    int fd = this->clientSock;
+    if (fd >= 0) shutdown(fd, SHUT_RDWR);
+    if (this->ioThread.joinable() &&
+        this->ioThread.get_id() != std::this_thread::get_id())
+        this->ioThread.join();
+    this->acceptWake.notify(); // Réveille un waitForClient() en cours
+    // Relève arrêtée avant de fermer serverSock, qu'elle peut être en train
+    // de céder (et handedOff alors fixé)
+    if (this->handoffSock >= 0) {
+        this->handoffWake.notify();
+        this->handoffThread.join();
+        close(this->handoffSock);
+        this->handoffSock = -1;
     }
     if (this->serverSock >= 0) {
-        shutdown(this->serverSock, SHUT_RDWR);
+        // Socket héritée ou cédée seulement fermée: toujours partagée avec le
+        // gestionnaire de services ou la relève, qui y acceptent encore
+        if (!this->inherited && !this->handedOff)
+            shutdown(this->serverSock, SHUT_RDWR);
         close(this->serverSock);
         this->serverSock = -1;
+        TransportStats all;
+        {
+            std::lock_guard<std::mutex> lock(this->statsMutex);
+            all = this->totals;
+        }
+        logStats("Instance", all);
+    }
+    if (this->watching) {
+        this->watching = false;
+        this->watchWake.notify();
+        this->watchThread.join();
+        close(this->watchSock);
+        this->watchSock = -1;
+    }
+    // La relève voit la fin de sa connexion: plus aucun client à recevoir
+    for (int* peer : {&this->successorSock, &this->predecessorSock}) {
+        if (*peer >= 0) close(*peer);
+        *peer = -1;
     }
     Logger::log("[UdsTransport] Serveur arrêté");
 }
 
-bool UdsTransport::isClientConnected() const { return clientSock >= 0; }
+bool UdsTransport::isClientConnected() const {
+    // Connecté tant que des messages reçus restent à lire
+    return this->connected || hasMessage();
+}
 
-std::string UdsTransport::serializeMessage(const Message& msg) const {
+std::string UdsTransport::serializeMessage(const Message& msg) {
     std::string result = msg.getType() + "\n";
     for (const auto& [key, value] : msg.getFields())
         result += key + "=" + value + "\n";
     return result + "\n";
 }
 
-Message UdsTransport::parseMessage(const std::string& data) const {
+Message UdsTransport::parseMessage(const std::string& data) {
     std::istringstream stream(data);
     std::string line;
 
     // Première ligne = type du message
-    if (!std::getline(stream, line) || line.empty()) {
-        Logger::err("[UdsTransport] Erreur: Type de message manquant");
-        return Message("error");
-    }
+    if (!std::getline(stream, line) || line.empty()) return Message("error");
 
     // Enlever le \r si présent (pour compatibilité Windows)
     if (line.back() == '\r') line.pop_back();
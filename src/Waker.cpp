@@ -0,0 +1,43 @@
+#include "Waker.hpp"
+#include "Logger.hpp"
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+Waker::Waker() {
+#ifdef __linux__
+    this->readFd = this->writeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#else
+    int fds[2];
+    if (pipe(fds) == 0) {
+        for (int fd : fds) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        this->readFd = fds[0];
+        this->writeFd = fds[1];
+    }
+#endif
+    // COUVERTURE: Qu’en cas d’épuisement des descripteurs de fichiers
+    if (this->readFd < 0) Logger::err("[Waker] Erreur: Création impossible");
+}
+
+Waker::~Waker() {
+    if (this->writeFd >= 0 && this->writeFd != this->readFd)
+        close(this->writeFd);
+    if (this->readFd >= 0) close(this->readFd);
+}
+
+void Waker::notify() const {
+    uint64_t one = 1; // eventfd: compteur 64 bits, tube: premier octet
+    ssize_t written = write(this->writeFd, &one, sizeof(one));
+    (void)written; // Tube plein ou compteur non nul: déjà signalé
+}
+
+void Waker::drain() const {
+    uint64_t count[8];
+    while (read(this->readFd, count, sizeof(count)) > 0) {}
+}
@@ -1,30 +1,58 @@
 #include "GameEngine.hpp"
 #include "Logger.hpp"
+#include "MidiFileInput.hpp"
 #include "RtMidiInput.hpp"
+#include "SyntheticMidiInput.hpp"
+#include "TappedTransport.hpp"
 #include "UdsTransport.hpp"
+#include "Waker.hpp"
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
 #include <csignal>
 #include <cstdlib>
+#include <exception>
+#include <poll.h>
 #include <print>
 #include <string>
 #include <thread>
 
 // Variables globales pour gestion signaux de terminaison
-static GameEngine* g_engine = nullptr;
-static UdsTransport* g_transport = nullptr;
+static volatile std::sig_atomic_t g_signal = 0; ///< Dernier signal reçu
+static Waker g_shutdown; ///< Réveille le thread principal pour l'arrêt
 
 /**
  * @brief Gestionnaire de signaux pour arrêts propres
+ * Seul write() y est sûr: l'arrêt se fait dans le thread principal
  * @param signum Numéro du signal reçu
  */
 void signalHandler(int signum) {
-    Logger::log("[MAIN] Signal reçu: {}", signum);
-    if (g_engine) g_engine->stop();
-    if (g_transport) g_transport->stop();
+    int saved = errno; // Inchangé pour le code interrompu
+    g_signal = signum;
+    g_shutdown.notify();
+    errno = saved;
 }
 
 int main(int argc, char* argv[]) {
     bool verbose = false;
+    int heartbeatMs = 0; // Battement de cœur désactivé par défaut
+    int heartbeatMisses = 3;
+    int sendQueue = 0; // File d'envoi par défaut (BackpressurePolicy)
+    bool observers = false;
+    int resumeGrace = -1; // Délai de reprise par défaut (GameEngine)
+    int listenFd = UdsTransport::listenFdFromEnv(); // Activation par socket
+    bool handoff = false;  // Relève possible par une nouvelle instance
+    bool takeover = false; // Relève d'une instance en cours
+    ChordWindowPolicy chordWindow; // Bornes de la fenêtre d'accord adaptative
+    ChordMode chordMode = ChordMode::Window;
+    int chordStableMs = 30;
+    int midiPorts = 1;        // Ports matériels ouverts (0 = tous)
+    int midiHotplugMs = 1000; // Recherche des claviers (0 = désactivée)
+    // Minuteur d'accord: priorité temps réel et cœur dédié
+    RealtimePolicy midiRealtime;
+    std::string midiFile;     // Performance rejouée au lieu d'un clavier
+    double midiSpeed = 1.0;   // Vitesse de lecture (0 = sans attente)
+    bool synthetic = false;   // Joueur simulé au lieu d'un clavier
     // Gestion de --timeout pour les tests/profilage et --verbose/-v
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -38,6 +66,50 @@ int main(int argc, char* argv[]) {
                 }).detach();
         } else if (arg == "--verbose" || arg == "-v") {
             verbose = true;
+        } else if (arg == "--heartbeat" && i + 1 < argc) {
+            heartbeatMs = std::atoi(argv[++i]); // Intervalle `ping` (ms)
+        } else if (arg == "--heartbeat-misses" && i + 1 < argc) {
+            heartbeatMisses = std::atoi(argv[++i]);
+        } else if (arg == "--send-queue" && i + 1 < argc) {
+            sendQueue = std::atoi(argv[++i]); // Délestage, coupure au quadruple
+        } else if (arg == "--observers") {
+            observers = true; // Spectateurs sur <socket>.watch
+        } else if (arg == "--resume-grace" && i + 1 < argc) {
+            resumeGrace = std::atoi(argv[++i]); // Secondes, 0 = désactivée
+        } else if (arg == "--listen-fd" && i + 1 < argc) {
+            listenFd = std::atoi(argv[++i]); // Socket en écoute du parent
+        } else if (arg == "--handoff") {
+            handoff = true; // Socket de contrôle <socket>.ctl
+        } else if (arg == "--takeover") {
+            takeover = true;
+        } else if (arg == "--chord-window-min" && i + 1 < argc) {
+            chordWindow.minimum =
+                std::chrono::milliseconds(std::atoi(argv[++i]));
+        } else if (arg == "--chord-window-max" && i + 1 < argc) {
+            chordWindow.maximum =
+                std::chrono::milliseconds(std::atoi(argv[++i]));
+        } else if (arg == "--chord-mode" && i + 1 < argc) {
+            std::string mode = argv[++i]; // window, release ou stable
+            if (mode == "release") chordMode = ChordMode::Release;
+            if (mode == "stable") chordMode = ChordMode::Stable;
+        } else if (arg == "--chord-stable" && i + 1 < argc) {
+            chordStableMs = std::atoi(argv[++i]); // Délai du mode stable
+        } else if (arg == "--midi-ports" && i + 1 < argc) {
+            midiPorts = std::atoi(argv[++i]); // Claviers fusionnés (0 = tous)
+        } else if (arg == "--midi-hotplug" && i + 1 < argc) {
+            midiHotplugMs = std::atoi(argv[++i]); // Période (ms)
+        } else if (arg == "--midi-rt-priority" && i + 1 < argc) {
+            midiRealtime.priority = std::atoi(argv[++i]); // SCHED_FIFO
+        } else if (arg == "--midi-rt-rr") {
+            midiRealtime.roundRobin = true; // SCHED_RR au lieu de SCHED_FIFO
+        } else if (arg == "--midi-cpu" && i + 1 < argc) {
+            midiRealtime.cpu = std::atoi(argv[++i]); // Cœur du minuteur
+        } else if (arg == "--midi-file" && i + 1 < argc) {
+            midiFile = argv[++i]; // Fichier MIDI standard (.mid)
+        } else if (arg == "--midi-speed" && i + 1 < argc) {
+            midiSpeed = std::atof(argv[++i]);
+        } else if (arg == "--synthetic") {
+            synthetic = true; // Répond aux défis, vitesse --midi-speed
         }
     }
     Logger::init();
@@ -49,10 +121,42 @@ int main(int argc, char* argv[]) {
     std::signal(SIGTERM, signalHandler);
     try {
         UdsTransport transport;
-        g_transport = &transport; // Garder référence pour le signal handler
+        if (heartbeatMs > 0)
+            transport.setHeartbeat(std::chrono::milliseconds(heartbeatMs),
+                                   std::max(1, heartbeatMisses));
+        if (sendQueue > 0)
+            transport.setBackpressure(
+                {.maxQueued = static_cast<size_t>(sendQueue),
+                 .disconnectAfter = 4 * static_cast<size_t>(sendQueue)});
+        if (listenFd >= 0) transport.adoptListener(listenFd);
+        if (observers)
+            transport.enableObservers(transport.getSocketPath() + ".watch");
         RtMidiInput midi;
-        GameEngine engine(transport, midi); // Création du moteur de jeu
-        g_engine = &engine;       // Garder référence pour le signal handler
+        midi.setChordWindow(chordWindow);
+        midi.setChordMode(chordMode, std::chrono::milliseconds(chordStableMs));
+        midi.setMaxPorts(static_cast<size_t>(std::max(0, midiPorts)));
+        midi.setHotplug(std::chrono::milliseconds(std::max(0, midiHotplugMs)));
+        midi.setRealtime(midiRealtime);
+        MidiFileInput replay(midiFile, midiSpeed);
+        replay.setChordWindow(chordWindow);
+        IMidiInput& input = midiFile.empty()
+                                ? static_cast<IMidiInput&>(midi)
+                                : static_cast<IMidiInput&>(replay);
+        // Joueur simulé: défis présentés au fil des envois du moteur
+        SyntheticMidiInput performer(PerformerModel{}, midiSpeed);
+        TappedTransport tapped(transport, [&performer](const Message& msg) {
+            performer.onChallenge(msg);
+        });
+        GameEngine engine(synthetic ? static_cast<ITransport&>(tapped)
+                                    : static_cast<ITransport&>(transport),
+                          synthetic ? performer : input); // Moteur de jeu
+        if (resumeGrace >= 0)
+            engine.setResumeGrace(std::chrono::seconds(resumeGrace));
+        // Mise à jour à chaud: l'ancienne instance finit sa partie et s'arrête
+        std::string control = transport.getSocketPath() + ".ctl";
+        if (takeover && listenFd < 0) transport.takeOver(control);
+        if (handoff) transport.enableHandoff(control, [&] { engine.drain(); });
+        engine.initializeMidiAsync(); // Ports MIDI ouverts en parallèle
         if (!transport.start()) { // Démarrage du transport
             Logger::err(
                 "[MAIN] ERREUR FATALE: Impossible de démarrer le transport");
@@ -60,14 +164,28 @@ int main(int argc, char* argv[]) {
                          transport.getSocketPath());
             return 1;
         }
-        engine.run(); // Lancement moteur (boucle d’évènements principale)
+        // Moteur dans son propre thread, arrêté depuis le thread principal
+        std::exception_ptr failure;
+        std::thread engineThread([&] {
+            try {
+                engine.run(); // Boucle d’évènements principale
+            } catch (...) {
+                failure = std::current_exception();
+            }
+            g_shutdown.notify(); // Arrêt de lui-même (relève, exception)
+        });
+        pollfd pfd{g_shutdown.fd(), POLLIN, 0};
+        while (poll(&pfd, 1, -1) < 0 && errno == EINTR) {}
+        if (g_signal != 0)
+            Logger::log("[MAIN] Signal reçu: {}", static_cast<int>(g_signal));
+        engine.stop();       // Arrête aussi le transport
+        engineThread.join(); // Entrée MIDI fermée par le moteur
+        if (failure) std::rethrow_exception(failure);
     } catch (const std::exception& e) {
         Logger::err("[MAIN] EXCEPTION NON GÉRÉE: {}", e.what());
         std::println("Erreur fatale: {}", e.what());
         return 1;
     }
-    g_engine = nullptr;    // Nettoyage
-    g_transport = nullptr; // Nettoyage
     Logger::log("[MAIN] === Arrêt Smart Piano Engine ===");
     std::println("Smart Piano Engine arrêté");
     return 0;
@@ -0,0 +1,430 @@
+#include "LatencyHistogram.hpp"
+#include "Logger.hpp"
+#include "Message.hpp"
+#include "Note.hpp"
+#include "UdsTransport.hpp"
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <poll.h>
+#include <print>
+#include <rtmidi/RtMidi.h>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace std::chrono;
+
+/**
+ * @brief Paramètres de la campagne de charge
+ */
+struct LoadOptions {
+    std::string socketPath{"/tmp/smartpiano.sock"}; ///< Socket du moteur
+    uint32_t clients{1};       ///< Connexions (servies l'une après l'autre)
+    uint32_t sessions{10};     ///< Sessions par connexion
+    double rate{0};            ///< Sessions/s par connexion (0 = au plus vite)
+    std::string game{"note"};  ///< Type de jeu configuré
+    std::string scale{"c"};    ///< Gamme configurée
+    std::string mode{"maj"};   ///< Mode configuré
+    bool midi{false};          ///< Répondre aux challenges via MIDI
+    uint32_t answerDelayMs{0}; ///< Délai avant réponse MIDI (ms)
+    uint32_t timeoutMs{5000};  ///< Attente maximale d'une réponse (ms)
+};
+
+/**
+ * @brief Mesures collectées par une connexion (fusionnées en fin de campagne)
+ */
+struct LoadReport {
+    std::map<std::string, LatencyHistogram> latencies; ///< Par type de réponse
+    uint64_t challenges{0}; ///< Challenges reçus
+    uint64_t sessions{0};   ///< Sessions menées jusqu'au `over`
+    uint64_t errors{0};     ///< Erreurs (message `error`, timeout, coupure)
+};
+
+/**
+ * @brief Doublure MIDI: joue les réponses attendues sur le port virtuel du
+ * moteur, partagée par toutes les connexions (le moteur n'a qu'une entrée)
+ */
+class MidiStandIn {
+  private:
+    std::unique_ptr<RtMidiOut> out; ///< Sortie MIDI vers le moteur
+    std::mutex outMutex;            ///< Sérialise les envois MIDI
+
+  public:
+    /**
+     * @brief Ouvre le port d'entrée virtuel du moteur
+     * @return true si un port "SmartPianoEngine" a été trouvé et ouvert
+     */
+    bool open() {
+        try {
+            this->out = std::make_unique<RtMidiOut>(RtMidi::Api::UNSPECIFIED,
+                                                    "spload");
+            for (unsigned int i = 0; i < this->out->getPortCount(); ++i) {
+                std::string name = this->out->getPortName(i);
+                if (name.find("SmartPianoEngine") == std::string::npos ||
+                    name.find("input") == std::string::npos)
+                    continue;
+                this->out->openPort(i, "spload");
+                return true;
+            }
+        } catch (RtMidiError& error) {
+            std::println(stderr, "Erreur MIDI: {}", error.getMessage());
+        }
+        return false;
+    }
+
+    /**
+     * @brief Joue des notes simultanément (note on puis note off)
+     * @param notes Notes à jouer
+     */
+    void play(const std::vector<Note>& notes) {
+        std::lock_guard<std::mutex> lock(this->outMutex);
+        std::vector<unsigned char> msg(3);
+        for (const auto& note : notes) {
+            msg = {0x90, static_cast<unsigned char>(note.toMidi()), 100};
+            this->out->sendMessage(&msg);
+        }
+        for (const auto& note : notes) {
+            msg = {0x80, static_cast<unsigned char>(note.toMidi()), 0};
+            this->out->sendMessage(&msg);
+        }
+    }
+};
+
+/**
+ * @brief Client protocole minimal (une connexion UDS)
+ */
+class LoadClient {
+  private:
+    int sock{-1};       ///< Socket connectée au moteur
+    std::string buffer; ///< Octets reçus non encore découpés
+
+  public:
+    LoadClient(const LoadClient&) = delete;
+    LoadClient& operator=(const LoadClient&) = delete;
+    LoadClient() = default;
+    ~LoadClient() { disconnect(); }
+
+    /**
+     * @brief Connecte le client au moteur
+     * @param path Chemin de la socket Unix
+     * @return true si connecté
+     */
+    bool connect(const std::string& path) {
+        this->sock = socket(AF_UNIX, SOCK_STREAM, 0);
+        struct sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        if (::connect(this->sock, reinterpret_cast<sockaddr*>(&addr),
+                      sizeof(addr)) == 0)
+            return true;
+        disconnect();
+        return false;
+    }
+
+    void disconnect() {
+        if (this->sock >= 0) close(this->sock);
+        this->sock = -1;
+    }
+
+    /**
+     * @brief Envoie un message au moteur
+     * @param msg Message à envoyer
+     * @return true si envoyé
+     */
+    bool send(const Message& msg) {
+        std::string data = UdsTransport::serializeMessage(msg);
+        return ::send(this->sock, data.c_str(), data.size(), MSG_NOSIGNAL) ==
+               static_cast<ssize_t>(data.size());
+    }
+
+    /**
+     * @brief Attend le prochain message du moteur (hors `ping`, auquel il
+     * répond directement)
+     * @param timeout Attente maximale
+     * @return Message reçu, ou rien si timeout ou déconnexion
+     */
+    std::optional<Message> receive(milliseconds timeout) {
+        auto deadline = steady_clock::now() + timeout;
+        std::string frame;
+        char buf[4096];
+        while (true) {
+            while (UdsTransport::extractFrame(this->buffer, frame)) {
+                Message msg = UdsTransport::parseMessage(frame);
+                if (msg.getType() != "ping") return msg;
+                send(Message("pong", msg.getFields()));
+            }
+            auto left = duration_cast<milliseconds>(deadline -
+                                                    steady_clock::now());
+            struct pollfd pfd{this->sock, POLLIN, 0};
+            if (left.count() <= 0 ||
+                poll(&pfd, 1, static_cast<int>(left.count())) <= 0)
+                return std::nullopt;
+            ssize_t n = recv(this->sock, buf, sizeof(buf), 0);
+            if (n <= 0) return std::nullopt;
+            this->buffer.append(buf, n);
+        }
+    }
+};
+
+/**
+ * @brief Extrait les notes attendues d'un challenge `note` ou `chord`
+ * @param challenge Message de challenge
+ * @return Notes à jouer pour répondre juste
+ */
+std::vector<Note> expectedNotes(const Message& challenge) {
+    std::vector<Note> notes;
+    std::istringstream stream(challenge.getType() == "note"
+                                  ? challenge.getField("note")
+                                  : challenge.getField("notes"));
+    std::string token;
+    while (stream >> token) notes.emplace_back(token);
+    return notes;
+}
+
+/**
+ * @brief Convertit un entier positif, sans exception
+ * @param text Texte à convertir
+ * @param value Valeur lue (inchangée si invalide)
+ * @return true si le texte entier est un nombre valide
+ */
+bool parseNumber(const std::string& text, uint32_t& value) {
+    const char* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, value);
+    return ec == std::errc{} && ptr == end && !text.empty();
+}
+
+/**
+ * @brief Attend une réponse et enregistre sa latence sous son type
+ * Les annonces `gametype` restantes sont ignorées
+ * @param client Connexion
+ * @param report Mesures de la connexion
+ * @param sentAt Instant d'envoi de la requête déclenchante
+ * @param timeout Attente maximale
+ * @return Message reçu, ou rien (compté en erreur)
+ */
+std::optional<Message> await(LoadClient& client, LoadReport& report,
+                             steady_clock::time_point sentAt,
+                             milliseconds timeout) {
+    auto msg = client.receive(timeout);
+    while (msg && msg->getType() == "gametype") // Fin des annonces initiales
+        msg = client.receive(timeout);
+    if (!msg) {
+        report.errors++;
+        return std::nullopt;
+    }
+    report.latencies[msg->getType()].record(steady_clock::now() - sentAt);
+    if (msg->getType() == "error") report.errors++;
+    return msg;
+}
+
+/**
+ * @brief Déroule une session complète: config, ready répétés, quit
+ * Sans doublure MIDI, chaque challenge est abandonné par `quit`
+ * @param client Connexion établie
+ * @param opts Paramètres de campagne
+ * @param midi Doublure MIDI éventuelle
+ * @param report Mesures de la connexion
+ * @return false si la connexion est inutilisable
+ */
+bool runSession(LoadClient& client, const LoadOptions& opts, MidiStandIn* midi,
+                LoadReport& report) {
+    milliseconds timeout(opts.timeoutMs);
+    auto sentAt = steady_clock::now();
+    client.send(Message("config", {{"game", opts.game},
+                                   {"scale", opts.scale},
+                                   {"mode", opts.mode}}));
+    auto ack = await(client, report, sentAt, timeout);
+    if (!ack) return false;
+    if (ack->getType() != "ack" || ack->getField("status") != "ok")
+        return true; // Erreur déjà comptée, session suivante
+    // Nombre de challenges annoncé par le moteur: pas de `ready` après le
+    // dernier résultat (le moteur enchaîne sur `over`)
+    uint32_t challenges = 0;
+    if (!parseNumber(ack->getField("challenges"), challenges) ||
+        challenges == 0) {
+        report.errors++;
+        client.send(Message("quit"));
+        return true;
+    }
+    sentAt = steady_clock::now();
+    client.send(Message("ready"));
+    uint32_t results = 0;
+    while (true) {
+        auto msg = await(client, report, sentAt, timeout);
+        if (!msg) return false;
+        if (msg->getType() == "over") break;
+        // Après le dernier résultat, le moteur envoie `over` sans `ready`
+        if (msg->getType() == "result" && ++results < challenges) {
+            sentAt = steady_clock::now();
+            client.send(Message("ready"));
+            continue;
+        }
+        if (msg->getType() != "note" && msg->getType() != "chord") continue;
+        report.challenges++;
+        if (midi) {
+            std::this_thread::sleep_for(milliseconds(opts.answerDelayMs));
+            midi->play(expectedNotes(*msg));
+        } else {
+            client.send(Message("quit")); // Abandon, attendre le `over`
+        }
+        sentAt = steady_clock::now();
+    }
+    report.sessions++;
+    sentAt = steady_clock::now();
+    client.send(Message("quit")); // Retour à l'état non configuré
+    return true;
+}
+
+/**
+ * @brief Boucle d'une connexion: sessions cadencées selon `rate`
+ * @param opts Paramètres de campagne
+ * @param midi Doublure MIDI éventuelle
+ * @param report Mesures de la connexion
+ */
+void runClient(const LoadOptions& opts, MidiStandIn* midi,
+               LoadReport& report) {
+    LoadClient client;
+    auto connectStart = steady_clock::now();
+    if (!client.connect(opts.socketPath)) {
+        report.errors++;
+        return;
+    }
+    // Le moteur annonce ses jeux dès qu'il prend en charge la connexion:
+    // latence `gametype` = attente avant d'être servi
+    auto announce = client.receive(milliseconds(opts.timeoutMs));
+    if (!announce) {
+        report.errors++;
+        return;
+    }
+    report.latencies["gametype"].record(steady_clock::now() - connectStart);
+    auto period = opts.rate > 0 ? duration_cast<nanoseconds>(
+                                      duration<double>(1.0 / opts.rate))
+                                : nanoseconds(0);
+    auto next = steady_clock::now();
+    for (uint32_t i = 0; i < opts.sessions; ++i) {
+        std::this_thread::sleep_until(next);
+        next += period;
+        if (!runSession(client, opts, midi, report)) break;
+    }
+}
+
+/**
+ * @brief Affiche l'aide de la ligne de commande
+ */
+void printUsage() {
+    std::println(
+        "Usage: spload [options]\n"
+        "  --socket <chemin>     Socket du moteur (/tmp/smartpiano.sock)\n"
+        "  --clients <n>         Connexions ouvertes (1)\n"
+        "  --sessions <n>        Sessions par connexion (10)\n"
+        "  --rate <n>            Sessions/s par connexion (0 = au plus vite)\n"
+        "  --game <id>           Type de jeu (note)\n"
+        "  --scale <gamme>       Gamme (c)\n"
+        "  --mode <mode>         Mode (maj)\n"
+        "  --midi                Répondre via le port MIDI virtuel du moteur\n"
+        "  --answer-delay <ms>   Délai avant chaque réponse MIDI (0)\n"
+        "  --timeout <ms>        Attente maximale d'une réponse (5000)\n"
+        "Le moteur ne sert qu'un client à la fois: connexions servies l'une\n"
+        "après l'autre, débit et latences ne sont pas ceux d'une charge\n"
+        "concurrente (latence `gametype` = attente en file).");
+}
+
+/**
+ * @brief Analyse les arguments de la ligne de commande
+ * @param argc Nombre d'arguments
+ * @param argv Arguments
+ * @return Paramètres de campagne, rien si un argument est invalide
+ */
+std::optional<LoadOptions> parseOptions(int argc, char* argv[]) {
+    LoadOptions opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--midi") {
+            opts.midi = true;
+            continue;
+        }
+        if (arg == "--help" || arg == "-h" || i + 1 >= argc)
+            return std::nullopt;
+        std::string value = argv[++i];
+        bool valid = true;
+        if (arg == "--socket") opts.socketPath = value;
+        else if (arg == "--clients") valid = parseNumber(value, opts.clients);
+        else if (arg == "--sessions") valid = parseNumber(value, opts.sessions);
+        else if (arg == "--rate") {
+            char* end = nullptr;
+            opts.rate = std::strtod(value.c_str(), &end);
+            valid = !value.empty() && *end == '\0' && opts.rate >= 0;
+        } else if (arg == "--game") opts.game = value;
+        else if (arg == "--scale") opts.scale = value;
+        else if (arg == "--mode") opts.mode = value;
+        else if (arg == "--answer-delay")
+            valid = parseNumber(value, opts.answerDelayMs);
+        else if (arg == "--timeout") valid = parseNumber(value, opts.timeoutMs);
+        else valid = false;
+        if (!valid) {
+            std::println(stderr, "Option invalide: {} {}", arg, value);
+            return std::nullopt;
+        }
+    }
+    return opts;
+}
+
+int main(int argc, char* argv[]) {
+    auto parsed = parseOptions(argc, argv);
+    if (!parsed) {
+        printUsage();
+        return 1;
+    }
+    const LoadOptions& opts = *parsed;
+    Logger::init("spload.log", "spload.err.log");
+    MidiStandIn standIn;
+    MidiStandIn* midi = nullptr;
+    if (opts.midi) {
+        if (!standIn.open()) {
+            std::println(stderr, "Port MIDI du moteur introuvable");
+            return 1;
+        }
+        midi = &standIn;
+    }
+    std::println("spload: {} connexion(s) x {} session(s) sur {} ({})",
+                 opts.clients, opts.sessions, opts.socketPath,
+                 midi ? "réponses MIDI" : "abandon par quit");
+    if (opts.clients > 1) // Moteur mono-client (file d'attente de 1)
+        std::println("Connexions servies l'une après l'autre par le moteur: "
+                     "mesures cumulées, non concurrentes");
+    std::vector<LoadReport> reports(opts.clients);
+    std::vector<std::thread> threads;
+    auto start = steady_clock::now();
+    for (uint32_t i = 0; i < opts.clients; ++i)
+        threads.emplace_back(runClient, std::cref(opts), midi,
+                             std::ref(reports[i]));
+    for (auto& t : threads) t.join();
+    double seconds = duration<double>(steady_clock::now() - start).count();
+    // Fusion des mesures de toutes les connexions
+    LoadReport total;
+    for (const auto& r : reports) {
+        for (const auto& [type, histogram] : r.latencies)
+            total.latencies[type].merge(histogram);
+        total.challenges += r.challenges;
+        total.sessions += r.sessions;
+        total.errors += r.errors;
+    }
+    std::println("Durée: {:.2f} s, sessions: {}, challenges: {} ({:.1f}/s), "
+                 "erreurs: {}",
+                 seconds, total.sessions, total.challenges,
+                 static_cast<double>(total.challenges) / seconds,
+                 total.errors);
+    for (const auto& [type, histogram] : total.latencies)
+        std::println("  {:<9} {}", type, histogram.summary());
+    return total.errors == 0 ? 0 : 2;
+}
@@ -0,0 +1,44 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "ChordWindow.hpp"
+#include <doctest/doctest.h>
+
+using namespace std::chrono_literals;
+
+/// Vérifie la fenêtre initiale et son resserrement pour un joueur rapide
+TEST_CASE("ChordWindow shrinks for fast players") {
+    ChordWindow window;
+    CHECK(window.current() == 100ms);
+    for (int i = 0; i < 30; ++i) window.observe(5ms); // Accords plaqués
+    CHECK(window.current() == 40ms);                  // Borne basse
+    CHECK(window.intraChord() < 10ms);
+}
+
+/// Vérifie l'élargissement pour un accord arpégé coupé par la fenêtre
+TEST_CASE("ChordWindow widens for rolled chords") {
+    ChordWindow window;
+    window.observe(120ms); // Au-delà de 100 ms: accord coupé en deux
+    CHECK(window.current() > 100ms);
+    for (int i = 0; i < 30; ++i) window.observe(120ms);
+    CHECK(window.current() == 250ms); // Borne haute
+    CHECK(window.interChord() == 0ms);
+}
+
+/// Vérifie que la fenêtre reste sous la moitié de l'écart entre accords
+TEST_CASE("ChordWindow bounded by interval between chords") {
+    ChordWindow window({.minimum = 40ms, .maximum = 1s, .initial = 100ms});
+    for (int i = 0; i < 30; ++i) window.observe(150ms);
+    CHECK(window.current() > 440ms); // 3 × 150 ms, moyenne arrondie
+    window.observe(1000ms);          // Au-delà du double: entre deux accords
+    CHECK(window.interChord() == 1000ms);
+    for (int i = 0; i < 30; ++i) window.observe(200ms);
+    CHECK(window.current() == 500ms); // 3 × 200 ms, borné par 1000 / 2
+}
+
+/// Vérifie qu'une fenêtre aux bornes égales reste fixe
+TEST_CASE("ChordWindow fixed when bounds are equal") {
+    ChordWindow window({.minimum = 80ms, .maximum = 80ms, .initial = 100ms});
+    CHECK(window.current() == 80ms);
+    window.observe(5ms);
+    window.observe(150ms);
+    CHECK(window.current() == 80ms);
+}
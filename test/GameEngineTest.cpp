@@ -31,6 +31,125 @@ TEST_CASE("GameEngine workflow") {
     if (engineThread.joinable()) engineThread.join();
 }
 
+/// Vérifie le signalement au client des branchements de clavier
+TEST_CASE("GameEngine reports MIDI device changes") {
+    MockTransport transport;
+    MockMidiInput midi;
+    {
+        GameEngine engine(transport, midi);
+        REQUIRE(midi.deviceListener);
+        midi.deviceListener("reface CP", 0, true); // Aucun client: rien envoyé
+        CHECK(transport.sentMessages.empty());
+        transport.waitForClient();
+        midi.deviceListener("reface CP", 0, false);
+        Message device = transport.waitForSentMessage();
+        CHECK(device.getType() == "device");
+        CHECK(device.getField("id") == "0");
+        CHECK(device.getField("name") == "reface CP");
+        CHECK(device.getField("state") == "disconnected");
+    }
+    CHECK_FALSE(midi.deviceListener); // Retiré à la destruction du moteur
+}
+
+/// Vérifie que l'entrée MIDI reste ouverte d'une partie à l'autre
+TEST_CASE("GameEngine keeps MIDI open between sessions") {
+    MockTransport transport;
+    MockMidiInput midi;
+    GameEngine engine(transport, midi);
+    auto paused = [&midi] {
+        std::lock_guard<std::mutex> lock(midi.mtx);
+        return midi.paused;
+    };
+
+    std::thread engineThread([&engine]() { engine.run(); });
+    transport.waitForClient();
+    for (int i = 0; i < 3; ++i) transport.waitForSentMessage();
+
+    Message config("config",
+                   {{"game", "note"}, {"scale", "c"}, {"mode", "maj"}});
+    transport.pushIncoming(config);
+    CHECK(transport.waitForSentMessage().getField("status") == "ok");
+    transport.pushIncoming(Message("quit")); // Partie arrêtée avant `ready`
+    for (int i = 0; i < 100 && !paused(); ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK(paused()); // Lecture suspendue, périphérique conservé
+    CHECK_FALSE(midi.closed);
+    CHECK(midi.isReady()); // Aucune réinitialisation à la partie suivante
+
+    transport.pushIncoming(config);
+    CHECK(transport.waitForSentMessage().getField("status") == "ok");
+    transport.pushIncoming(Message("ready"));
+    CHECK(transport.waitForSentMessage().getType() == "note");
+    CHECK_FALSE(paused()); // Reprise au lancement de la partie
+
+    engine.stop();
+    if (engineThread.joinable()) engineThread.join();
+    CHECK(midi.closed); // Fermée à l'arrêt du moteur
+}
+
+/// Vérifie qu'une partie arrêtée en cours de challenge n'envoie aucun résultat
+TEST_CASE("GameEngine stop during a challenge") {
+    MockTransport transport;
+    MockMidiInput midi;
+    GameEngine engine(transport, midi);
+
+    std::thread engineThread([&engine]() { engine.run(); });
+    transport.waitForClient();
+    for (int i = 0; i < 3; ++i) transport.waitForSentMessage();
+    transport.pushIncoming(
+        Message("config", {{"game", "note"}, {"scale", "c"}, {"mode", "maj"}}));
+    CHECK(transport.waitForSentMessage().getField("status") == "ok");
+    transport.pushIncoming(Message("ready"));
+    CHECK(transport.waitForSentMessage().getType() == "note");
+
+    engine.stop(); // Aucune note jouée: challenge ni noté, ni suivi d'autres
+    if (engineThread.joinable()) engineThread.join();
+    for (const Message& sent : transport.sentMessages) {
+        CHECK(sent.getType() != "result");
+        CHECK(sent.getType() != "note");
+    }
+}
+
+/// Vérifie l'initialisation MIDI anticipée, reprise au premier `config`
+TEST_CASE("GameEngine initializes MIDI before the first config") {
+    MockTransport transport;
+    MockMidiInput midi;
+    Message config("config",
+                   {{"game", "note"}, {"scale", "c"}, {"mode", "maj"}});
+
+    SUBCASE("Device ready before the client") {
+        GameEngine engine(transport, midi);
+        engine.initializeMidiAsync();
+        for (int i = 0; i < 100 && !midi.initializeCalls; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        CHECK(midi.initializeCalls == 1); // Sans attendre le client
+        std::thread engineThread([&engine]() { engine.run(); });
+        transport.waitForClient();
+        for (int i = 0; i < 3; ++i) transport.waitForSentMessage();
+        transport.pushIncoming(config);
+        CHECK(transport.waitForSentMessage().getField("status") == "ok");
+        CHECK(midi.initializeCalls == 1); // Résultat repris, pas refait
+        engine.stop();
+        engineThread.join();
+    }
+
+    SUBCASE("Missing device tried again on config") {
+        midi.setInitializeResult(false);
+        GameEngine engine(transport, midi);
+        engine.initializeMidiAsync();
+        std::thread engineThread([&engine]() { engine.run(); });
+        transport.waitForClient();
+        for (int i = 0; i < 3; ++i) transport.waitForSentMessage();
+        transport.pushIncoming(config);
+        Message error = transport.waitForSentMessage();
+        CHECK(error.getType() == "error");
+        CHECK(error.getField("code") == "midi");
+        CHECK(midi.initializeCalls == 2); // Clavier peut-être branché depuis
+        engine.stop();
+        engineThread.join();
+    }
+}
+
 /// Vérifie la gestion des erreurs de configuration et états invalides
 /// Test configs invalides, modes inconnus, MIDI non prêt, messages inattendus
 TEST_CASE("GameEngine Error Handling") {
@@ -254,6 +373,67 @@ TEST_CASE("GameEngine Session Interruptions") {
     if (engineThread.joinable()) engineThread.join();
 }
 
+/// Vérifie reprise d'une partie après reconnexion du client (`resume`)
+/// Le challenge interrompu est renvoyé à l'identique, jeton invalide refusé
+TEST_CASE("GameEngine session resume") {
+    MockTransport transport;
+    MockMidiInput midi;
+    GameEngine engine(transport, midi);
+    std::thread engineThread([&engine]() { engine.run(); });
+    transport.waitForClient();
+    for (int i = 0; i < 3; ++i) transport.waitForSentMessage();
+
+    transport.pushIncoming(
+        Message("config", {{"game", "note"}, {"scale", "c"}, {"mode", "maj"}}));
+    Message ack = transport.waitForSentMessage();
+    REQUIRE(ack.getField("status") == "ok");
+    const std::string token = ack.getField("token");
+    CHECK(token.size() == 32);
+
+    transport.pushIncoming(Message("ready"));
+    midi.pushNotes({"c4"});
+    transport.waitForSentMessage(); // Challenge 1
+    CHECK(transport.waitForSentMessage().getType() == "result");
+    transport.pushIncoming(Message("ready"));
+    Message challenge = transport.waitForSentMessage();
+    REQUIRE(challenge.getType() == "note");
+    CHECK(challenge.getField("id") == "2");
+
+    transport.stop(); // Crash de l'interface pendant le challenge 2
+    for (int i = 0; i < 3; ++i) // Reconnexion: `gametype`, pas de `over`
+        CHECK(transport.waitForSentMessage().getType() == "gametype");
+
+    SUBCASE("Valid token") {
+        transport.pushIncoming(Message("resume", {{"token", token}}));
+        Message resumed = transport.waitForSentMessage();
+        CHECK(resumed.getType() == "ack");
+        CHECK(resumed.getField("status") == "ok");
+        CHECK(resumed.getField("total") == "1");
+
+        transport.pushIncoming(Message("ready"));
+        Message again = transport.waitForSentMessage();
+        CHECK(again.getType() == "note");
+        CHECK(again.getField("id") == "2");
+        CHECK(again.getField("note") == challenge.getField("note"));
+
+        transport.pushIncoming(Message("quit"));
+        Message over = transport.waitForSentMessage();
+        CHECK(over.getType() == "over");
+        CHECK(over.getField("total") == "1"); // Cumule la partie interrompue
+    }
+
+    SUBCASE("Invalid token") {
+        transport.pushIncoming(Message("resume", {{"token", "bad"}}));
+        Message refused = transport.waitForSentMessage();
+        CHECK(refused.getType() == "ack");
+        CHECK(refused.getField("status") == "error");
+        CHECK(refused.getField("code") == "resume");
+    }
+
+    engine.stop();
+    if (engineThread.joinable()) engineThread.join();
+}
+
 /// Vérifie gestion résultats partiels dans message "over"
 /// Test couverture lignes 104-105 (result.partial > 0)
 /// Vérifie gestion résultats partiels dans message "over"
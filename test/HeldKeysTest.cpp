@@ -0,0 +1,37 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "HeldKeys.hpp"
+#include <doctest/doctest.h>
+
+/// Vérifie enfoncement, relâchement et liste ordonnée des touches
+TEST_CASE("HeldKeys press and release") {
+    HeldKeys keys;
+    CHECK(keys.empty());
+    for (uint8_t key : {127, 64, 0, 63, 60}) keys.press(key);
+    keys.press(60); // Déjà enfoncée
+    CHECK(keys.count() == 5);
+    CHECK(keys.held(63));
+    CHECK_FALSE(keys.held(65));
+    CHECK(keys.keys() == std::vector<uint8_t>{0, 60, 63, 64, 127});
+    keys.release(64);
+    keys.release(65); // Non enfoncée
+    CHECK(keys.count() == 4);
+    CHECK_FALSE(keys.held(64));
+    HeldKeys copy = keys;
+    CHECK(copy == keys);
+    keys.clear();
+    CHECK(keys.empty());
+    CHECK(keys.keys().empty());
+    CHECK_FALSE(copy == keys);
+}
+
+/// Vérifie la différence de deux ensembles, dans chaque moitié du clavier
+TEST_CASE("HeldKeys without") {
+    HeldKeys held;
+    HeldKeys stale;
+    for (uint8_t key : {60, 64, 67, 100}) held.press(key);
+    for (uint8_t key : {60, 100, 30}) stale.press(key);
+    CHECK(held.without(stale).keys() == std::vector<uint8_t>{64, 67});
+    CHECK(stale.without(held).keys() == std::vector<uint8_t>{30});
+    CHECK(held.without(HeldKeys{}) == held);
+    CHECK(held.without(held).empty());
+}
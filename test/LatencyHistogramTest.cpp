@@ -0,0 +1,44 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "LatencyHistogram.hpp"
+#include <doctest/doctest.h>
+
+using namespace std::chrono_literals;
+
+/// Vérifie compteurs, extrêmes et moyenne de l'histogramme
+TEST_CASE("LatencyHistogram basic statistics") {
+    LatencyHistogram histogram;
+    CHECK(histogram.count() == 0);
+    CHECK(histogram.min() == 0);
+    CHECK(histogram.percentileUs(50) == 0);
+    histogram.record(100us);
+    histogram.record(300us);
+    histogram.record(2ms);
+    CHECK(histogram.count() == 3);
+    CHECK(histogram.min() == 100);
+    CHECK(histogram.max() == 2000);
+    CHECK(histogram.mean() == 800);
+    CHECK(histogram.summary().starts_with("n=3 min=100"));
+}
+
+/// Vérifie percentiles approchés par seaux logarithmiques
+TEST_CASE("LatencyHistogram percentiles") {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 99; ++i) histogram.record(10us); // Seau [8, 16)
+    histogram.record(5ms);
+    CHECK(histogram.percentileUs(50) == 15);
+    CHECK(histogram.percentileUs(100) == 5000); // Borné par le maximum
+    histogram.record(-1ms); // Mesure négative ramenée à 0
+    CHECK(histogram.min() == 0);
+}
+
+/// Vérifie fusion de deux histogrammes
+TEST_CASE("LatencyHistogram merge") {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    a.record(1ms);
+    b.record(3ms);
+    a.merge(b);
+    CHECK(a.count() == 2);
+    CHECK(a.min() == 1000);
+    CHECK(a.max() == 3000);
+}
@@ -0,0 +1,210 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "MidiFile.hpp"
+#include "MidiFileInput.hpp"
+#include <doctest/doctest.h>
+#include <filesystem>
+#include <fstream>
+#include <initializer_list>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace std::chrono;
+
+/// Octets d'un fichier MIDI, écrits comme dans la norme
+static std::string bytes(std::initializer_list<int> values) {
+    std::string out;
+    for (int v : values) out += static_cast<char>(v);
+    return out;
+}
+
+/// Bloc MIDI: identifiant, longueur sur 4 octets gros-boutistes, contenu
+static std::string chunk(const std::string& id, const std::string& body) {
+    size_t n = body.size();
+    return id + bytes({int(n >> 24) & 0xFF, int(n >> 16) & 0xFF,
+                       int(n >> 8) & 0xFF, int(n) & 0xFF}) +
+           body;
+}
+
+/// En-tête MThd
+static std::string header(int format, int tracks, int division) {
+    return chunk("MThd", bytes({0, format, 0, tracks, division >> 8,
+                                division & 0xFF}));
+}
+
+static MidiFile parse(const std::string& data) {
+    std::istringstream in(data);
+    return MidiFile::parse(in);
+}
+
+/// Accord do-mi-sol arpégé (10 ms entre attaques), puis do5 une seconde
+/// après: 100 ticks par noire, noire d'une seconde (1 tick = 10 ms)
+static std::string arpeggio() {
+    return header(0, 1, 100) +
+           chunk("MTrk", bytes({0x00, 0xFF, 0x51, 0x03, 0x0F, 0x42, 0x40,
+                                0x00, 0x90, 60, 100, // Do4
+                                0x01, 64, 90,        // Statut courant
+                                0x01, 67, 80,        // Sol4
+                                0x62, 72, 70,        // 980 ms plus tard
+                                0x00, 0xFF, 0x2F, 0x00}));
+}
+
+/// Fichier temporaire rejoué par MidiFileInput
+static std::string writeFile(const std::string& data) {
+    auto path = std::filesystem::temp_directory_path() / "test_replay.mid";
+    std::ofstream(path, std::ios::binary) << data;
+    return path.string();
+}
+
+TEST_CASE("MIDI file events timed by the tempo map") {
+    MidiFile file = parse(
+        header(0, 1, 96) +
+        chunk("MTrk", bytes({0x00, 0x90, 60, 100,      // 0 µs
+                             0x60, 64, 90,             // Noire à 500000 µs
+                             0x00, 0xFF, 0x51, 0x03,   // Tempo doublé
+                             0x03, 0xD0, 0x90,         // 250000 µs/noire
+                             0x00, 0xF0, 0x02, 1, 2,   // Exclusif ignoré
+                             0x60, 0x80, 60, 0,        // Noire à 250000 µs
+                             0x00, 0xC0, 5,            // Une seule donnée
+                             0x00, 0xFF, 0x2F, 0x00})));
+    CHECK(file.getFormat() == 0);
+    CHECK(file.getTracks() == 1);
+    const auto& events = file.getEvents();
+    REQUIRE(events.size() == 4);
+    CHECK(events[0].time == microseconds(0));
+    CHECK(events[1].status == 0x90); // Repris du message précédent
+    CHECK(events[1].data1 == 64);
+    CHECK(events[1].data2 == 90);
+    CHECK(events[1].time == microseconds(500000));
+    CHECK(events[2].status == 0x80);
+    CHECK(events[2].time == microseconds(750000));
+    CHECK(events[3].status == 0xC0);
+    CHECK(events[3].data1 == 5);
+}
+
+TEST_CASE("MIDI file tracks merged in time order") {
+    // Format 1: tempo en piste 0, mélodie et basse entrelacées
+    MidiFile file = parse(
+        header(1, 3, 480) +
+        chunk("MTrk", bytes({0x00, 0xFF, 0x51, 0x03, 0x07, 0xA1, 0x20,
+                             0x00, 0xFF, 0x2F, 0x00})) +
+        chunk("XFIH", bytes({1, 2, 3})) + // Bloc inconnu ignoré
+        chunk("MTrk", bytes({0x00, 0x90, 72, 100, 0x83, 0x60, 74, 100,
+                             0x00, 0xFF, 0x2F, 0x00})) +
+        chunk("MTrk", bytes({0x00, 0x91, 48, 100, 0x81, 0x70, 50, 100,
+                             0x00, 0xFF, 0x2F, 0x00})));
+    CHECK(file.getTracks() == 3);
+    const auto& events = file.getEvents();
+    REQUIRE(events.size() == 4);
+    CHECK(events[0].data1 == 72); // Même tick: ordre des pistes conservé
+    CHECK(events[0].track == 1);
+    CHECK(events[1].data1 == 48);
+    CHECK(events[1].track == 2);
+    CHECK(events[2].data1 == 50); // 240 ticks à 500000 µs/noire
+    CHECK(events[2].time == microseconds(250000));
+    CHECK(events[3].data1 == 74); // 480 ticks
+    CHECK(events[3].time == microseconds(500000));
+}
+
+TEST_CASE("MIDI file rejects malformed data") {
+    CHECK_THROWS_AS(parse("RIFF"), std::runtime_error);
+    CHECK_THROWS_AS(parse(header(0, 1, 0)), std::runtime_error);
+    CHECK_THROWS_AS(
+        parse(header(0, 1, 96) + chunk("MTrk", bytes({0x00, 0x90, 60}))),
+        std::runtime_error); // Tronqué
+    CHECK_THROWS_AS(
+        parse(header(0, 1, 96) + chunk("MTrk", bytes({0x00, 60, 100}))),
+        std::runtime_error); // Donnée sans statut
+    CHECK_THROWS_AS(parse(header(0, 1, 96) + "MTrk" + bytes({0, 0, 0, 9})),
+                    std::runtime_error);
+    CHECK_THROWS_AS(MidiFile::load("/nonexistent/file.mid"),
+                    std::runtime_error);
+}
+
+TEST_CASE("MidiFileInput replays chords as fast as possible") {
+    MidiFileInput input(writeFile(arpeggio()), 0.0);
+    CHECK_FALSE(input.isReady());
+    REQUIRE(input.initialize());
+    CHECK(input.isReady());
+    CHECK(input.remaining() == 4);
+    CHECK(input.hasNotes());
+    auto chord = input.readEvents(milliseconds(0));
+    REQUIRE(chord.has_value());
+    REQUIRE(chord->size() == 3); // Attaques à moins de la fenêtre
+    CHECK((*chord)[0].note == Note("c4"));
+    CHECK((*chord)[1].velocity == 90);
+    CHECK((*chord)[2].device == 0); // Piste d'origine
+    auto notes = input.readNotes(milliseconds(0));
+    REQUIRE(notes.has_value());
+    CHECK(*notes == std::vector<Note>{Note("c5")});
+    CHECK_FALSE(input.readEvents(milliseconds(10)).has_value()); // Fin
+    CHECK_FALSE(input.isStopped());
+    input.close();
+    CHECK_FALSE(input.isReady());
+    CHECK(input.isStopped());
+    CHECK_FALSE(input.readEvents(milliseconds(10)).has_value()); // Fermée
+}
+
+TEST_CASE("MidiFileInput keeps the original timing") {
+    MidiFileInput input(writeFile(arpeggio()), 10.0); // Dix fois plus vite
+    REQUIRE(input.initialize());
+    auto start = steady_clock::now();
+    // Accord finalisé une fenêtre après sa dernière attaque (≥ 2 + 4 ms)
+    CHECK_FALSE(input.readEvents(milliseconds(0)).has_value());
+    auto first = input.readEvents(milliseconds(500));
+    REQUIRE(first.has_value());
+    REQUIRE(first->size() == 3);
+    auto second = input.readEvents(milliseconds(500));
+    REQUIRE(second.has_value());
+    REQUIRE(second->size() == 1);
+    CHECK(steady_clock::now() - start >= milliseconds(100));
+    // Écarts du fichier divisés par la vitesse
+    CHECK((*first)[1].time - (*first)[0].time == milliseconds(1));
+    CHECK((*second)[0].time - (*first)[0].time == milliseconds(100));
+    input.close();
+}
+
+TEST_CASE("MidiFileInput pause keeps the position") {
+    MidiFileInput input(writeFile(arpeggio()), 10.0);
+    REQUIRE(input.initialize());
+    auto first = input.readEvents(milliseconds(500));
+    REQUIRE(first.has_value());
+    REQUIRE(first->size() == 3);
+    input.pause();
+    CHECK_FALSE(input.hasNotes());
+    CHECK(input.isStopped());
+    CHECK_FALSE(input.readEvents(milliseconds(500)).has_value()); // Débloquée
+    std::this_thread::sleep_for(milliseconds(150)); // Échéance dépassée
+    input.resume();
+    CHECK(input.remaining() == 1);
+    // Reprise: encore près de 100 ms avant do5, durée de la pause décomptée
+    CHECK_FALSE(input.readEvents(milliseconds(0)).has_value());
+    auto second = input.readEvents(milliseconds(500));
+    REQUIRE(second.has_value());
+    REQUIRE(second->size() == 1);
+    CHECK((*second)[0].note == Note("c5"));
+    input.close();
+}
+
+TEST_CASE("MidiFileInput expected note count splits chords") {
+    MidiFileInput input(writeFile(arpeggio()), 0.0);
+    REQUIRE(input.initialize());
+    input.expectNotes(2);
+    auto notes = input.readNotes(milliseconds(0));
+    REQUIRE(notes.has_value());
+    CHECK(*notes == std::vector<Note>{Note("c4"), Note("e4")});
+    input.expectNotes(0);
+    notes = input.readNotes(milliseconds(0));
+    REQUIRE(notes.has_value());
+    CHECK(*notes == std::vector<Note>{Note("g4")});
+    input.close();
+}
+
+TEST_CASE("MidiFileInput unreadable file") {
+    MidiFileInput missing("/nonexistent/file.mid");
+    CHECK_FALSE(missing.initialize());
+    CHECK_FALSE(missing.isReady());
+    MidiFileInput malformed(writeFile("MThd"));
+    CHECK_FALSE(malformed.initialize());
+}
@@ -5,37 +5,49 @@
 #include "ITransport.hpp"
 #include "Message.hpp"
 #include "Note.hpp"
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <mutex>
+#include <optional>
 #include <vector>
 
 class MockMidiInput : public IMidiInput {
   public:
     bool initialized = false;
     bool closed = false;
+    bool paused = false; // Entre deux parties (pause())
     bool initResult = true; // Default success
+    std::atomic<int> initializeCalls{0};
     std::deque<std::vector<Note>> notesQueue;
     std::mutex mtx;
     std::condition_variable cv;
+    DeviceListener deviceListener; // Branchements simulés par le test
 
     bool initialize() override {
+        initializeCalls++;
         if (initResult) {
             initialized = true;
         }
         return initResult;
     }
 
+    void onDeviceChange(DeviceListener listener) override {
+        deviceListener = std::move(listener);
+    }
+
     void setInitializeResult(bool res) { initResult = res; }
     void setReady(bool ready) { initialized = ready; }
 
     std::vector<Note> readNotes() override {
         std::unique_lock<std::mutex> lock(mtx);
         // Wait for notes to be available
-        cv.wait(lock, [this] { return !notesQueue.empty() || closed; });
+        cv.wait(lock, [this] {
+            return !notesQueue.empty() || closed || paused;
+        });
 
-        if (notesQueue.empty() && closed) {
+        if (paused || (notesQueue.empty() && closed)) {
             return {};
         }
 
@@ -44,6 +56,27 @@ class MockMidiInput : public IMidiInput {
         return notes;
     }
 
+    using IMidiInput::readNotes;
+
+    std::optional<std::vector<NoteEvent>>
+    readEvents(std::chrono::milliseconds timeout) override {
+        std::unique_lock<std::mutex> lock(mtx);
+        if (!cv.wait_for(lock, timeout, [this] {
+                return !notesQueue.empty() || closed || paused;
+            }))
+            return std::nullopt;
+        if (paused || notesQueue.empty()) return std::nullopt; // Arrêtée
+        std::vector<NoteEvent> events;
+        // Attaques datées à la lecture, comme jouées à l'instant
+        for (const Note& note : notesQueue.front())
+            events.push_back({.midi = static_cast<uint8_t>(note.toMidi()),
+                              .velocity = 100,
+                              .note = note,
+                              .time = std::chrono::steady_clock::now()});
+        notesQueue.pop_front();
+        return events;
+    }
+
     void close() override {
         {
             std::lock_guard<std::mutex> lock(mtx);
@@ -52,8 +85,26 @@ class MockMidiInput : public IMidiInput {
         cv.notify_all();
     }
 
+    void pause() override {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            paused = true;
+        }
+        cv.notify_all();
+    }
+
+    void resume() override {
+        std::lock_guard<std::mutex> lock(mtx);
+        paused = false;
+    }
+
     bool isReady() const override { return initialized && !closed; }
 
+    bool isStopped() const override {
+        std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(mtx));
+        return closed || paused;
+    }
+
     bool hasNotes() const override {
         std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(mtx));
         return !notesQueue.empty() || closed;
@@ -114,6 +165,23 @@ class MockTransport : public ITransport {
         return msg;
     }
 
+    std::optional<Message>
+    receive(std::chrono::milliseconds timeout) override {
+        std::unique_lock<std::mutex> lock(mtx);
+        if (!cv.wait_for(lock, timeout, [this] {
+                return !incomingMessages.empty() || !connected;
+            }))
+            return std::nullopt;
+        if (incomingMessages.empty()) return Message("error");
+        auto msg = incomingMessages.front();
+        incomingMessages.pop_front();
+        return msg;
+    }
+
+    std::optional<Message> tryReceive() override {
+        return receive(std::chrono::milliseconds(0));
+    }
+
     void stop() override {
         {
             std::lock_guard<std::mutex> lock(mtx);
@@ -134,7 +202,7 @@ class MockTransport : public ITransport {
     void pushIncoming(const Message& msg) {
         std::lock_guard<std::mutex> lock(mtx);
         incomingMessages.push_back(msg);
-        cv.notify_one();
+        cv.notify_all(); // Partagée avec waitForSentMessage()
     }
 
     // Helper to wait for a message sent by the game
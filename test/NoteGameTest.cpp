@@ -140,3 +140,52 @@ TEST_CASE("NoteGame Multiple Incorrect Notes") {
     game.stop();
     if (gameThread.joinable()) gameThread.join();
 }
+
+/// Vérifie fin de partie si le client se déconnecte pendant un challenge
+TEST_CASE("NoteGame Client Disconnect During Challenge") {
+    MockTransport transport;
+    MockMidiInput midi;
+    ChallengeFactory factory;
+    GameConfig config;
+    config.scale = "c";
+    config.mode = "maj";
+    config.maxChallenges = 3;
+    NoteGame game(transport, midi, factory, config);
+
+    transport.waitForClient();
+    game.start();
+    GameResult result{0, 0, 0, -1};
+    std::thread gameThread([&]() { result = game.play(); });
+
+    CHECK(transport.waitForSentMessage().getType() == "note");
+    transport.stop(); // Sans `quit`, ni note jouée
+
+    if (gameThread.joinable()) gameThread.join();
+    CHECK(result.total == 0);
+}
+
+/// Vérifie qu'un arrêt de la partie ou de l'entrée MIDI la termine sans noter
+/// le challenge en cours comme une réponse vide
+TEST_CASE("NoteGame Stopped During Challenge") {
+    MockTransport transport;
+    MockMidiInput midi;
+    ChallengeFactory factory;
+    GameConfig config;
+    config.scale = "c";
+    config.mode = "maj";
+    config.maxChallenges = 3;
+    NoteGame game(transport, midi, factory, config);
+
+    transport.waitForClient();
+    game.start();
+    GameResult result{0, 0, 0, -1};
+    std::thread gameThread([&]() { result = game.play(); });
+
+    CHECK(transport.waitForSentMessage().getType() == "note");
+    SUBCASE("Game stopped") { game.stop(); } // Entrée MIDI suspendue
+    SUBCASE("MIDI input closed") { midi.close(); }
+
+    if (gameThread.joinable()) gameThread.join();
+    CHECK(result.total == 0);
+    CHECK(transport.sentMessages.empty()); // Ni `result`, ni défi suivant
+}
@@ -1,4 +1,5 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "MidiNotes.hpp"
 #include "Note.hpp"
 #include <doctest/doctest.h>
 
@@ -60,3 +61,27 @@ TEST_CASE("Note equality") {
     CHECK(n1 == n2);
     CHECK(n1 != n3);
 }
+
+/// Vérifie conversion note vers numéro MIDI (altérations comprises)
+TEST_CASE("Note to MIDI number") {
+    CHECK(Note("c4").toMidi() == 60);
+    CHECK(Note("a4").toMidi() == 69);
+    CHECK(Note("c#4").toMidi() == 61);
+    CHECK(Note("db4").toMidi() == 61);
+    CHECK(Note("b0").toMidi() == 23);
+    CHECK(Note("c0").toMidi() == 12);
+}
+
+/// Vérifie la table MIDI: aller-retour avec toMidi(), bornes jouables
+TEST_CASE("MIDI number to Note table") {
+    for (uint8_t midi = 12; midi < 120; ++midi) {
+        const Note& note = midiToNote(midi);
+        CHECK(note.toMidi() == midi);
+        CHECK(note.toString() == MIDI_NOTE_NAMES[midi].str());
+    }
+    CHECK(&midiToNote(60) == &midiToNote(60)); // Construite une seule fois
+    CHECK_FALSE(MIDI_NOTE_NAMES[11].playable());
+    CHECK_FALSE(MIDI_NOTE_NAMES[120].playable());
+    CHECK_THROWS_AS(midiToNote(11), std::invalid_argument);
+    CHECK_THROWS_AS(midiToNote(120), std::invalid_argument);
+}
@@ -1,21 +1,25 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "RtMidiInput.hpp"
+#include <condition_variable>
 #include <deque>
 #include <doctest/doctest.h>
 #include <mutex>
 #include <rtmidi/RtMidi.h> // for RtMidiError
+#include <stdexcept>
 #include <thread>
+#include <tuple>
+#include <utility>
 
 /// Mock pour IRtMidiIn permettant injection messages MIDI de test
-/// Simule port virtuel MIDI et file messages pour tests
+/// Simule port virtuel MIDI, livrés au callback comme RtMidi (ou en file)
 class MockRtMidiIn : public IRtMidiIn {
   public:
     std::deque<std::vector<unsigned char>> messageQueue;
     std::mutex queueMutex;
+    Callback callback;
     bool openPortCalled = false;
     bool openVirtualPortCalled = false;
     bool throwOnOpen = false;
-    bool throwOnGet = false;
     std::vector<std::string> mockPorts = {"SmartPianoEngine Port",
                                           "Midi Through", "reface CP"};
 
@@ -42,7 +46,6 @@ class MockRtMidiIn : public IRtMidiIn {
     }
 
     double getMessage(std::vector<unsigned char>* message) override {
-        if (throwOnGet) throw std::runtime_error("Mock processing error");
         std::lock_guard<std::mutex> lock(queueMutex);
         if (messageQueue.empty()) {
             message->clear();
@@ -53,15 +56,41 @@ class MockRtMidiIn : public IRtMidiIn {
         return 0.0;
     }
 
-    unsigned int getPortCount() override { return mockPorts.size(); }
+    unsigned int getPortCount() override {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        return mockPorts.size();
+    }
     std::string getPortName(unsigned int portNumber) override {
+        std::lock_guard<std::mutex> lock(queueMutex);
         if (portNumber < mockPorts.size()) return mockPorts[portNumber];
         return "";
     }
 
-    void pushMessage(const std::vector<unsigned char>& msg) {
+    // Branchement ou débranchement pendant l'énumération
+    void setPorts(const std::vector<std::string>& ports) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        mockPorts = ports;
+    }
+
+    void setCallback(Callback cb) override {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        callback = std::move(cb);
+    }
+
+    void cancelCallback() override {
         std::lock_guard<std::mutex> lock(queueMutex);
-        messageQueue.push_back(msg);
+        callback = nullptr;
+    }
+
+    void pushMessage(const std::vector<unsigned char>& msg,
+                     double deltaTime = 0.0) {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if (!callback) {
+            messageQueue.push_back(msg);
+            return;
+        }
+        std::vector<unsigned char> copy = msg;
+        callback(deltaTime, &copy); // Comme le thread RtMidi, dès l'arrivée
     }
 };
 
@@ -92,6 +121,24 @@ class MockRtMidiOut : public IRtMidiOut {
     }
 };
 
+/// Mock pour IMidiRouter: abonnements relevés au lieu du séquenceur ALSA
+/// Relevé conservé par le test, le routeur étant détruit après initialize()
+using Routes = std::vector<std::pair<std::string, std::string>>;
+class MockMidiRouter : public IMidiRouter {
+  public:
+    Routes& routes;
+    bool result;
+
+    MockMidiRouter(Routes& connections, bool connectResult)
+        : routes(connections), result(connectResult) {}
+
+    bool connect(const std::string& source,
+                 const std::string& destination) override {
+        routes.emplace_back(source, destination);
+        return result;
+    }
+};
+
 /// RtMidiInput testable permettant injection mocks
 /// Surcharge createMidiIn/Out pour retourner mocks au lieu de vrais objets
 /// RtMidi
@@ -101,8 +148,18 @@ class TestableRtMidiInput : public RtMidiInput {
     MockRtMidiOut* mockOut = nullptr;
     bool forceCreateError = false;
     bool throwOnOpen = false;
+    bool routerCreated = false;
+    bool routeResult = true;
+    bool throwOnMessage = false;
+    Routes routes; ///< Abonnements demandés au routeur
 
   protected:
+    void onMidiMessage(MidiPort& port, double deltaTime,
+                       const std::vector<unsigned char>& message) override {
+        if (throwOnMessage) throw std::runtime_error("Mock processing error");
+        RtMidiInput::onMidiMessage(port, deltaTime, message);
+    }
+
     std::unique_ptr<IRtMidiIn> createMidiIn() override {
         if (forceCreateError)
             throw RtMidiError("Mock creation error", RtMidiError::DRIVER_ERROR);
@@ -117,6 +174,11 @@ class TestableRtMidiInput : public RtMidiInput {
         mockOut = m.get();
         return m;
     }
+
+    std::unique_ptr<IMidiRouter> createMidiRouter() override {
+        routerCreated = true;
+        return std::make_unique<MockMidiRouter>(routes, routeResult);
+    }
 };
 
 /// Vérifie initialisation réussie et ouverture ports MIDI
@@ -125,6 +187,7 @@ TEST_CASE("RtMidiInput initialization success (hardware detection)") {
     TestableRtMidiInput input;
     CHECK(input.initialize());
     CHECK(input.isReady());
+    CHECK_FALSE(input.routerCreated); // Aucun synthétiseur à router
     // Dans le mock par défaut, "reface CP" est trouvé
     CHECK(input.mockIn->openPortCalled);
     CHECK_FALSE(input.mockIn->openVirtualPortCalled);
@@ -151,6 +214,17 @@ TEST_CASE("RtMidiInput initialization with FluidSynth detection") {
     CHECK(input.isReady());
     CHECK(input.mockIn->openPortCalled);
     CHECK(input.mockOut->openVirtualPortCalled);
+    // Clavier abonné au synthétiseur, adresse ALSA extraite du nom du port
+    CHECK(input.routes == Routes{{"reface CP", "128:0"}});
+    input.close();
+}
+
+TEST_CASE("RtMidiInput routing failure keeps the keyboard") {
+    FluidSynthRtMidiInput input;
+    input.routeResult = false; // Ex: séquenceur ALSA indisponible
+    CHECK(input.initialize());
+    CHECK(input.isReady());
+    CHECK(input.routes.size() == 1);
     input.close();
 }
 
@@ -172,25 +246,42 @@ TEST_CASE("RtMidiInput fallback to virtual when no hardware found") {
     CHECK_FALSE(input.mockIn->openPortCalled);
     CHECK(input.mockIn->openVirtualPortCalled);
     CHECK(input.mockOut->openVirtualPortCalled);
+    input.mockIn->pushMessage({0x90, 60, 100});
+    auto events = input.readEvents(std::chrono::milliseconds(500));
+    REQUIRE(events.has_value());
+    REQUIRE(events->size() == 1);
+    CHECK((*events)[0].device == RtMidiInput::VIRTUAL_DEVICE); // Jamais 0
     input.close();
 }
 
-/// Vérifie gestion exception lors traitement messages MIDI
-/// Valide que thread continue après exception et ne plante pas
-TEST_CASE("RtMidiInput processing exception") {
+/// Vérifie que seuls les Note On complets produisent des notes
+/// Valide messages tronqués, Note Off et Note On de vélocité nulle ignorés
+TEST_CASE("RtMidiInput ignores other messages") {
     TestableRtMidiInput input;
     input.initialize();
+    input.mockIn->pushMessage({0x90, 60});      // Tronqué
+    input.mockIn->pushMessage({0x80, 60, 64});  // Note Off
+    input.mockIn->pushMessage({0x90, 62, 0});   // Note On vélocité 0 (Off)
+    input.mockIn->pushMessage({0xB0, 64, 127}); // Pédale
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    CHECK_FALSE(input.hasNotes());
+    input.close();
+}
 
-    // Configurer mock pour lancer exception sur getMessage
-    // On attend un peu pour s'assurer que thread le récupère
-    // Boucle thread attrape exception et continue
-    input.mockIn->throwOnGet = true;
-
-    std::this_thread::sleep_for(std::chrono::milliseconds(50));
-
-    // Restaurer normal pour fermer proprement
-    input.mockIn->throwOnGet = false;
-
+/// Vérifie gestion exception lors traitement messages MIDI (callback)
+/// Valide que l'exception ne remonte pas au thread RtMidi et que l'entrée
+/// reste utilisable ensuite
+TEST_CASE("RtMidiInput processing exception") {
+    TestableRtMidiInput input;
+    input.initialize();
+    input.throwOnMessage = true;
+    CHECK_NOTHROW(input.mockIn->pushMessage({0x90, 60, 100}));
+    input.throwOnMessage = false;
+    input.mockIn->pushMessage({0x90, 64, 100});
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    std::vector<Note> notes = input.readNotes();
+    REQUIRE(notes.size() == 1);
+    CHECK(notes[0].toString() == "e4");
     input.close();
 }
 
@@ -266,6 +357,344 @@ TEST_CASE("RtMidiInput chord processing") {
     input.close();
 }
 
+/// Vérifie rafale de notes (callback) regroupée en un accord par le minuteur
+/// Valide accord finalisé à son échéance, ni avant ni longtemps après
+TEST_CASE("RtMidiInput burst finalized by chord timer") {
+    using namespace std::chrono;
+    TestableRtMidiInput input;
+    input.setChordWindow({.minimum = milliseconds(100),
+                          .maximum = milliseconds(100)}); // Fenêtre fixe
+    input.initialize();
+    for (unsigned char midi = 60; midi < 76; ++midi)
+        input.mockIn->pushMessage({0x90, midi, 100});
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK_FALSE(input.hasNotes()); // Échéance de l'accord pas atteinte
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    CHECK(input.hasNotes());
+    CHECK(input.readNotes().size() == 16);
+    input.close();
+}
+
+TEST_CASE("RtMidiInput chord window adapts to the player") {
+    using namespace std::chrono;
+    TestableRtMidiInput input;
+    input.initialize();
+    CHECK(input.getStats().chordWindow == milliseconds(100));
+    for (unsigned char midi = 60; midi < 76; ++midi)
+        input.mockIn->pushMessage({0x90, midi, 100}); // Accord plaqué
+    auto notes = input.readNotes(milliseconds(80)); // Fenêtre resserrée
+    REQUIRE(notes.has_value());
+    CHECK(notes->size() == 16);
+    MidiInputStats stats = input.getStats();
+    CHECK(stats.chords == 1);
+    CHECK(stats.dropped == 0);
+    CHECK(stats.chordWindow < milliseconds(100));
+    input.close();
+}
+
+/// Vérifie qu'un accord finalisé n'est pas écrasé par le suivant
+/// Valide accords lus dans l'ordre, même finalisés avant la lecture
+TEST_CASE("RtMidiInput keeps chords finalized before being read") {
+    TestableRtMidiInput input;
+    input.initialize();
+    input.mockIn->pushMessage({0x90, 60, 100});
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    input.mockIn->pushMessage({0x90, 64, 100});
+    input.mockIn->pushMessage({0x90, 67, 100});
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    // Deux accords finalisés, aucun écrasé par le suivant
+    std::vector<Note> first = input.readNotes();
+    REQUIRE(first.size() == 1);
+    CHECK(first[0].toString() == "c4");
+    CHECK(input.readNotes().size() == 2);
+    CHECK_FALSE(input.hasNotes());
+    CHECK(input.droppedCount() == 0);
+    input.close();
+}
+
+TEST_CASE("RtMidiInput readNotes woken by close") {
+    TestableRtMidiInput input;
+    input.initialize();
+    std::thread closer([&input] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        input.close();
+    });
+    CHECK(input.readNotes().empty()); // Attente sans note, débloquée
+    closer.join();
+}
+
+TEST_CASE("RtMidiInput paused between games") {
+    using namespace std::chrono;
+    TestableRtMidiInput input;
+    REQUIRE(input.initialize());
+    MockRtMidiIn* keyboard = input.mockIn;
+    input.pause();
+    CHECK(input.isReady()); // Ports et threads conservés
+    CHECK(input.isStopped());
+    CHECK_FALSE(input.readNotes(seconds(2)).has_value()); // Débloquée
+    input.mockIn->pushMessage({0x90, 60, 100}); // Joué entre deux parties
+    std::this_thread::sleep_for(milliseconds(200));
+    input.resume();
+    CHECK_FALSE(input.isStopped());
+    CHECK_FALSE(input.readNotes(milliseconds(20)).has_value()); // Écarté
+    keyboard->pushMessage({0x90, 64, 100});
+    auto notes = input.readNotes(seconds(2));
+    REQUIRE(notes.has_value());
+    CHECK(*notes == std::vector<Note>{Note("e4")});
+    CHECK(input.mockIn == keyboard); // Aucune réinitialisation
+    input.close();
+}
+
+TEST_CASE("RtMidiInput real-time policy falls back gracefully") {
+    using namespace std::chrono;
+    TestableRtMidiInput input;
+    // Cœur inexistant, priorité souvent refusée: minuteur inchangé
+    input.setRealtime({.priority = 99, .roundRobin = true, .cpu = 1 << 20});
+    REQUIRE(input.initialize());
+    input.mockIn->pushMessage({0x90, 60, 100});
+    auto notes = input.readNotes(seconds(2));
+    REQUIRE(notes.has_value());
+    CHECK(notes->size() == 1);
+    // Accord finalisé à l'échéance: retard du réveil mesuré
+    CHECK(input.getStats().timerLate > microseconds(0));
+    input.close();
+}
+
+TEST_CASE("RtMidiInput timed readNotes") {
+    using namespace std::chrono;
+    TestableRtMidiInput input;
+    input.initialize();
+    CHECK_FALSE(input.readNotes(milliseconds(20)).has_value()); // Délai écoulé
+    auto start = steady_clock::now();
+    input.mockIn->pushMessage({0x90, 60, 100});
+    auto notes = input.readNotes(seconds(2));
+    auto waited = steady_clock::now() - start;
+    REQUIRE(notes.has_value());
+    CHECK(notes->size() == 1);
+    // Réveillé dès la fin de l'accord, sans attendre le délai
+    CHECK(waited >= milliseconds(100));
+    CHECK(waited < milliseconds(500));
+    CHECK_FALSE(input.isStopped());
+    input.close();
+    CHECK(input.isStopped());
+    CHECK_FALSE(input.readNotes(seconds(2)).has_value()); // Fermée
+}
+
+TEST_CASE("RtMidiInput expected note count finalizes early") {
+    using namespace std::chrono;
+    TestableRtMidiInput input;
+    input.initialize();
+    input.expectNotes(3);
+    input.mockIn->pushMessage({0x90, 60, 100});
+    input.mockIn->pushMessage({0x90, 60, 100}); // Répétée: comptée une fois
+    input.mockIn->pushMessage({0x90, 64, 100});
+    CHECK_FALSE(input.readNotes(milliseconds(50)).has_value());
+    input.mockIn->pushMessage({0x90, 67, 100});
+    auto notes = input.readNotes(milliseconds(50)); // Bien avant 100 ms
+    REQUIRE(notes.has_value());
+    CHECK(notes->size() == 4);
+    input.expectNotes(0); // Retour au délai seul
+    input.mockIn->pushMessage({0x90, 72, 100});
+    CHECK_FALSE(input.readNotes(milliseconds(50)).has_value());
+    CHECK(input.readNotes(milliseconds(200)).has_value());
+    input.close();
+}
+
+TEST_CASE("RtMidiInput chord finalized on release") {
+    using namespace std::chrono;
+    TestableRtMidiInput input;
+    input.setChordMode(ChordMode::Release);
+    input.initialize();
+    input.mockIn->pushMessage({0x90, 67, 100});
+    input.mockIn->pushMessage({0x90, 60, 100});
+    std::this_thread::sleep_for(milliseconds(150)); // Accord arpégé lent
+    input.mockIn->pushMessage({0x90, 64, 100});
+    input.mockIn->pushMessage({0x80, 60, 0});
+    input.mockIn->pushMessage({0x90, 67, 0});
+    CHECK_FALSE(input.readNotes(milliseconds(300)).has_value()); // e4 tenue
+    input.mockIn->pushMessage({0x80, 64, 0});
+    auto notes = input.readNotes(milliseconds(50));
+    REQUIRE(notes.has_value());
+    // Touches tenues ensemble, par ordre croissant
+    CHECK(*notes == std::vector<Note>{Note("c4"), Note("e4"), Note("g4")});
+    input.close();
+}
+
+TEST_CASE("RtMidiInput chord finalized when held keys are stable") {
+    using namespace std::chrono;
+    TestableRtMidiInput input;
+    input.setChordMode(ChordMode::Stable, milliseconds(30));
+    input.initialize();
+    input.mockIn->pushMessage({0x90, 60, 100});
+    input.mockIn->pushMessage({0x90, 64, 100});
+    auto notes = input.readNotes(milliseconds(200)); // Touches encore tenues
+    REQUIRE(notes.has_value());
+    CHECK(notes->size() == 2);
+    input.mockIn->pushMessage({0x80, 60, 0});
+    input.mockIn->pushMessage({0x80, 64, 0});
+    CHECK_FALSE(input.readNotes(milliseconds(100)).has_value()); // Déjà lu
+    input.mockIn->pushMessage({0x90, 72, 100});
+    input.mockIn->pushMessage({0x80, 72, 0}); // Relâchée avant stabilité
+    notes = input.readNotes(milliseconds(20));
+    REQUIRE(notes.has_value());
+    CHECK(*notes == std::vector<Note>{Note("c5")});
+    input.close();
+}
+
+TEST_CASE("RtMidiInput next chord ignores keys still held") {
+    using namespace std::chrono;
+    TestableRtMidiInput input;
+    SUBCASE("Stable") { input.setChordMode(ChordMode::Stable); }
+    SUBCASE("Release") { input.setChordMode(ChordMode::Release); }
+    input.initialize();
+    input.expectNotes(2); // Finalisé touches encore tenues
+    input.mockIn->pushMessage({0x90, 60, 100});
+    input.mockIn->pushMessage({0x90, 64, 100});
+    auto notes = input.readNotes(milliseconds(200));
+    REQUIRE(notes.has_value());
+    CHECK(notes->size() == 2);
+    input.expectNotes(0);
+    input.mockIn->pushMessage({0x90, 67, 100}); // do4 et mi4 toujours tenues
+    input.mockIn->pushMessage({0x80, 67, 0});
+    notes = input.readNotes(milliseconds(200));
+    REQUIRE(notes.has_value());
+    CHECK(*notes == std::vector<Note>{Note("g4")});
+    input.mockIn->pushMessage({0x80, 60, 0});
+    input.mockIn->pushMessage({0x80, 64, 0});
+    input.mockIn->pushMessage({0x90, 60, 100}); // Rejouée: attaque nouvelle
+    input.mockIn->pushMessage({0x80, 60, 0});
+    notes = input.readNotes(milliseconds(200));
+    REQUIRE(notes.has_value());
+    CHECK(*notes == std::vector<Note>{Note("c4")});
+    input.close();
+}
+
+TEST_CASE("RtMidiInput note events timed by the device") {
+    using namespace std::chrono;
+    TestableRtMidiInput input;
+    input.initialize(); // Port matériel "reface CP" (index 2)
+    input.mockIn->pushMessage({0x90, 60, 90});
+    std::this_thread::sleep_for(milliseconds(5));
+    input.mockIn->pushMessage({0x90, 64, 70}, 0.002); // 2 ms selon le clavier
+    auto events = input.readEvents(milliseconds(500));
+    REQUIRE(events.has_value());
+    REQUIRE(events->size() == 2);
+    CHECK((*events)[0].midi == 60);
+    CHECK((*events)[0].velocity == 90);
+    CHECK((*events)[0].device == 0); // Premier port ouvert, pas son index
+    CHECK((*events)[1].note == Note("e4"));
+    CHECK((*events)[1].velocity == 70);
+    auto gap = (*events)[1].time - (*events)[0].time;
+    CHECK(gap > microseconds(1900));
+    CHECK(gap < microseconds(2100));
+    input.close();
+}
+
+/// Deux claviers branchés: chaque port ouvert par sa propre instance RtMidi
+/// Instances créées aussi par la surveillance des branchements
+class MultiPortRtMidiInput : public TestableRtMidiInput {
+  private:
+    std::vector<MockRtMidiIn*> mockIns;
+    std::mutex mocksMutex;
+
+  public:
+    size_t mockCount() {
+        std::lock_guard<std::mutex> lock(mocksMutex);
+        return mockIns.size();
+    }
+    MockRtMidiIn* mock(size_t index) {
+        std::lock_guard<std::mutex> lock(mocksMutex);
+        return mockIns.at(index);
+    }
+
+  protected:
+    std::unique_ptr<IRtMidiIn> createMidiIn() override {
+        auto m = std::make_unique<MockRtMidiIn>();
+        m->mockPorts = {"Midi Through", "reface CP", "LPD8"};
+        std::lock_guard<std::mutex> lock(mocksMutex);
+        mockIns.push_back(m.get());
+        return m;
+    }
+};
+
+TEST_CASE("RtMidiInput opens only the first keyboard by default") {
+    MultiPortRtMidiInput input;
+    CHECK(input.initialize());
+    CHECK(input.portCount() == 1);
+    REQUIRE(input.mockCount() == 1);
+    CHECK(input.mock(0)->openPortCalled);
+    input.close();
+}
+
+TEST_CASE("RtMidiInput merges several keyboards into one stream") {
+    using namespace std::chrono;
+    MultiPortRtMidiInput input;
+    input.setMaxPorts(0); // Tous les ports détectés
+    CHECK(input.initialize());
+    CHECK(input.portCount() == 2);
+    REQUIRE(input.mockCount() == 2);
+    CHECK(input.mock(1)->openPortCalled);
+    input.expectNotes(2);
+    input.mock(0)->pushMessage({0x90, 60, 90}); // reface CP (0)
+    input.mock(1)->pushMessage({0x90, 64, 70}); // LPD8 (1)
+    auto events = input.readEvents(milliseconds(500));
+    REQUIRE(events.has_value());
+    REQUIRE(events->size() == 2);
+    CHECK((*events)[0].midi == 60);
+    CHECK((*events)[0].device == 0);
+    CHECK((*events)[1].midi == 64);
+    CHECK((*events)[1].device == 1);
+    CHECK((*events)[0].time <= (*events)[1].time);
+    input.close();
+    CHECK_FALSE(input.isReady());
+}
+
+TEST_CASE("RtMidiInput follows keyboards plugged in after start") {
+    using namespace std::chrono;
+    MultiPortRtMidiInput input;
+    std::mutex mtx;
+    std::condition_variable cv;
+    using Change = std::tuple<std::string, unsigned, bool>;
+    std::vector<Change> changes;
+    input.onDeviceChange([&](const std::string& name, unsigned device,
+                             bool connected) {
+        std::lock_guard<std::mutex> lock(mtx);
+        changes.emplace_back(name, device, connected);
+        cv.notify_all();
+    });
+    auto waitChanges = [&](size_t count) {
+        std::unique_lock<std::mutex> lock(mtx);
+        return cv.wait_for(lock, seconds(2),
+                           [&] { return changes.size() >= count; });
+    };
+    input.setHotplug(milliseconds(5));
+    CHECK(input.initialize()); // "reface CP" ouvert (un seul port)
+    REQUIRE(input.mockCount() == 2); // Port ouvert et surveillance
+    MockRtMidiIn* scanner = input.mock(1);
+    scanner->setPorts({"Midi Through"}); // Tous débranchés
+    REQUIRE(waitChanges(1));
+    CHECK(changes[0] == Change{"reface CP", 0, false});
+    CHECK(input.isReady()); // Port virtuel en attendant
+    CHECK(input.mock(2)->openVirtualPortCalled);
+    scanner->setPorts({"LPD8", "Midi Through", "reface CP"}); // Rebranchés
+    REQUIRE(waitChanges(2));
+    CHECK(changes[1] == Change{"LPD8", 1, true}); // Pas son index 0
+    REQUIRE(input.mockCount() == 4); // "reface CP" ignoré (un seul port)
+    MockRtMidiIn* plugged = input.mock(3);
+    CHECK(plugged->openPortCalled);
+    plugged->pushMessage({0x90, 60, 100});
+    auto events = input.readEvents(milliseconds(500));
+    REQUIRE(events.has_value());
+    REQUIRE(events->size() == 1);
+    CHECK((*events)[0].device == 1);
+    scanner->setPorts({"reface CP"}); // Clavier remplacé
+    REQUIRE(waitChanges(4));
+    CHECK(changes[2] == Change{"reface CP", 2, true}); // Jamais réutilisé
+    CHECK(changes[3] == Change{"LPD8", 1, false});
+    input.close();
+    CHECK(changes.size() == 4);
+}
+
 /// Expose méthodes protégées pour tester vraies implémentations RtMidi
 /// Permet tester factory methods et classes wrapper réelles partiellement
 class ExposeRealRtMidiInput : public RtMidiInput {
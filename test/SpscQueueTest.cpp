@@ -0,0 +1,43 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "SpscQueue.hpp"
+#include <doctest/doctest.h>
+#include <string>
+#include <thread>
+
+/// Vérifie l'ordre FIFO, la capacité et le comptage des débordements
+TEST_CASE("SpscQueue bounded FIFO") {
+    SpscQueue<std::string, 4> queue;
+    CHECK(queue.empty());
+    CHECK_FALSE(queue.tryPop().has_value());
+    for (int i = 0; i < 4; ++i) CHECK(queue.tryPush(std::to_string(i)));
+    CHECK(queue.size() == 4);
+    CHECK_FALSE(queue.tryPush("4")); // Pleine: refusé, compté
+    CHECK(queue.overflowCount() == 1);
+    CHECK(queue.tryPop() == "0");
+    CHECK(queue.tryPush("5")); // Emplacement libéré réutilisé
+    for (const char* expected : {"1", "2", "3", "5"})
+        CHECK(queue.tryPop() == expected);
+    CHECK(queue.empty());
+    CHECK(queue.overflowCount() == 1);
+}
+
+/// Producteur et consommateur concurrents: aucun élément perdu ni désordonné
+TEST_CASE("SpscQueue concurrent producer and consumer") {
+    constexpr int COUNT = 100000;
+    SpscQueue<int, 64> queue;
+    std::thread producer([&queue] {
+        for (int i = 0; i < COUNT; ++i)
+            while (!queue.tryPush(i)) std::this_thread::yield();
+    });
+    int expected = 0;
+    bool ordered = true;
+    while (expected < COUNT) {
+        if (auto value = queue.tryPop())
+            ordered = ordered && *value == expected++;
+        else
+            std::this_thread::yield();
+    }
+    producer.join();
+    CHECK(ordered);
+    CHECK(queue.empty());
+}
@@ -0,0 +1,155 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include "GameEngine.hpp"
+#include "Mocks.hpp"
+#include "SyntheticMidiInput.hpp"
+#include "TappedTransport.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <doctest/doctest.h>
+#include <thread>
+
+using namespace std::chrono;
+
+/// Joueur sans erreur, réaction fixe de 200 ms, accords plaqués
+static PerformerModel perfect() {
+    return {.reaction = milliseconds(200),
+            .reactionSpread = 0.0,
+            .errorRate = 0.0,
+            .wrongOctaveRate = 0.0,
+            .rollSpread = milliseconds(0),
+            .seed = 42};
+}
+
+TEST_CASE("SyntheticMidiInput answers note challenges") {
+    SyntheticMidiInput input(perfect(), 0.0);
+    CHECK_FALSE(input.isReady());
+    REQUIRE(input.initialize());
+    CHECK(input.isReady());
+    CHECK_FALSE(input.hasNotes());
+    CHECK_FALSE(input.readEvents(milliseconds(10)).has_value()); // Aucun défi
+    auto shown = steady_clock::now();
+    input.onChallenge(Message("result", {{"correct", "c4"}})); // Ignoré
+    input.onChallenge(Message("note", {{"note", "e4"}, {"id", "1"}}));
+    CHECK(input.challengeCount() == 1);
+    CHECK(input.hasNotes()); // Sans attente: réponse immédiate
+    auto events = input.readEvents(milliseconds(0));
+    REQUIRE(events.has_value());
+    REQUIRE(events->size() == 1);
+    CHECK((*events)[0].note == Note("e4"));
+    CHECK((*events)[0].midi == 64);
+    // Instant fictif: réaction du modèle, sans l'avoir attendue
+    auto reaction = (*events)[0].time - shown;
+    CHECK(reaction >= milliseconds(199));
+    CHECK(reaction <= milliseconds(250));
+    CHECK_FALSE(input.hasNotes()); // Réponse lue une seule fois
+    CHECK(input.mistakeCount() == 0);
+    input.close();
+}
+
+TEST_CASE("SyntheticMidiInput rolls chords in real time") {
+    PerformerModel model = perfect();
+    model.reaction = milliseconds(20);
+    model.rollSpread = milliseconds(30);
+    SyntheticMidiInput input(model, 1.0);
+    REQUIRE(input.initialize());
+    auto start = steady_clock::now();
+    input.onChallenge(Message("chord", {{"name", "C"}, {"notes", "c4 e4 g4"}}));
+    CHECK_FALSE(input.readEvents(milliseconds(0)).has_value()); // Pas encore
+    auto events = input.readEvents(milliseconds(500));
+    REQUIRE(events.has_value());
+    REQUIRE(events->size() == 3);
+    CHECK(steady_clock::now() - start >= milliseconds(20));
+    // Attaques ordonnées, étalées sur au plus rollSpread
+    CHECK((*events)[0].time <= (*events)[1].time);
+    CHECK((*events)[1].time <= (*events)[2].time);
+    CHECK((*events)[2].time - (*events)[0].time <= milliseconds(30));
+    std::vector<Note> played;
+    for (const NoteEvent& event : *events) played.push_back(event.note);
+    std::ranges::sort(played, {}, &Note::toMidi);
+    CHECK(played == std::vector<Note>{Note("c4"), Note("e4"), Note("g4")});
+    input.close();
+}
+
+TEST_CASE("SyntheticMidiInput plays wrong notes") {
+    SUBCASE("Neighbouring keys") {
+        PerformerModel model = perfect();
+        model.errorRate = 1.0;
+        SyntheticMidiInput input(model, 0.0);
+        REQUIRE(input.initialize());
+        for (int i = 0; i < 20; ++i) {
+            input.onChallenge(Message("note", {{"note", "e4"}}));
+            auto events = input.readEvents(milliseconds(0));
+            REQUIRE(events.has_value());
+            REQUIRE(events->size() == 1);
+            int offset = (*events)[0].midi - 64;
+            CHECK(offset != 0);
+            CHECK(std::abs(offset) <= 2);
+            CHECK((*events)[0].note.toMidi() == (*events)[0].midi);
+        }
+        CHECK(input.mistakeCount() == 20);
+    }
+
+    SUBCASE("Wrong octave") {
+        PerformerModel model = perfect();
+        model.wrongOctaveRate = 1.0;
+        SyntheticMidiInput input(model, 0.0);
+        REQUIRE(input.initialize());
+        input.onChallenge(Message("note", {{"note", "a4"}}));
+        auto events = input.readEvents(milliseconds(0));
+        REQUIRE(events.has_value());
+        REQUIRE(events->size() == 1);
+        CHECK(std::abs((*events)[0].midi - 69) == 12);
+        CHECK(input.mistakeCount() == 1);
+    }
+}
+
+TEST_CASE("SyntheticMidiInput close unblocks readEvents") {
+    SyntheticMidiInput input(perfect(), 1.0);
+    REQUIRE(input.initialize());
+    std::thread closer([&input] {
+        std::this_thread::sleep_for(milliseconds(20));
+        input.close();
+    });
+    auto events = input.readEvents(seconds(5));
+    closer.join();
+    CHECK_FALSE(events.has_value()); // Fermée, aucun accord vide
+    CHECK(input.isStopped());
+    CHECK_FALSE(input.isReady());
+    input.onChallenge(Message("note", {{"note", "c4"}})); // Plus de réponse
+    CHECK(input.challengeCount() == 0);
+}
+
+/// Le joueur simulé répond aux défis du moteur, présentés par le transport
+TEST_CASE("SyntheticMidiInput drives a GameEngine session") {
+    MockTransport transport;
+    SyntheticMidiInput input(perfect(), 0.0);
+    TappedTransport tapped(
+        transport, [&input](const Message& msg) { input.onChallenge(msg); });
+    GameEngine engine(tapped, input);
+
+    std::thread engineThread([&engine]() { engine.run(); });
+    transport.waitForClient();
+    for (int i = 0; i < 3; ++i) transport.waitForSentMessage();
+
+    transport.pushIncoming(
+        Message("config", {{"game", "note"}, {"scale", "c"}, {"mode", "maj"}}));
+    CHECK(transport.waitForSentMessage().getField("status") == "ok");
+    transport.pushIncoming(Message("ready"));
+    for (int i = 0; i < 3; ++i) {
+        Message challenge = transport.waitForSentMessage();
+        REQUIRE(challenge.getType() == "note");
+        Message result = transport.waitForSentMessage();
+        REQUIRE(result.getType() == "result");
+        CHECK(result.getField("id") == challenge.getField("id"));
+        CHECK(result.getField("correct") == challenge.getField("note"));
+        // Temps de réaction du modèle, mesuré sans l'attendre
+        int duration = std::stoi(result.getField("duration"));
+        CHECK(duration >= 190);
+        CHECK(duration <= 250);
+        transport.pushIncoming(Message("ready"));
+    }
+    CHECK(input.challengeCount() == 3);
+
+    engine.stop();
+    if (engineThread.joinable()) engineThread.join();
+}
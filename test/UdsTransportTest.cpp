@@ -1,7 +1,9 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "UdsTransport.hpp"
+#include <atomic>
 #include <chrono>
 #include <doctest/doctest.h>
+#include <fcntl.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <thread>
@@ -384,3 +386,313 @@ TEST_CASE("UdsTransport send without client") {
         transport.stop();
     }
 }
+
+/// Connecte un client UDS brut au serveur de test
+/// @return Descripteur socket client (-1 si échec)
+int connectRawClient(const std::string& path) {
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+    if (connect(sock, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+/// Vérifie découpage de plusieurs messages reçus en un seul envoi
+TEST_CASE("UdsTransport several messages in one packet") {
+    std::string socketPath = "test_multi.sock";
+    UdsTransport transport(socketPath);
+    if (transport.start()) {
+        std::thread client([&]() {
+            int sock = connectRawClient(socketPath);
+            std::string msg = "ready\n\nquit\n\n";
+            ::send(sock, msg.c_str(), msg.length(), 0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            close(sock);
+        });
+        transport.waitForClient();
+        CHECK(transport.receive().getType() == "ready");
+        CHECK(transport.receive().getType() == "quit");
+        if (client.joinable()) client.join();
+        transport.stop();
+    }
+}
+
+/// Vérifie mesure temps aller-retour par battements de cœur ping/pong
+/// Le client répond aux ping, ping client reçoit pong sans remonter au moteur
+TEST_CASE("UdsTransport heartbeat RTT") {
+    std::string socketPath = "test_heartbeat.sock";
+    UdsTransport transport(socketPath);
+    transport.setHeartbeat(std::chrono::milliseconds(20));
+    if (transport.start()) {
+        std::thread client([&]() {
+            int sock = connectRawClient(socketPath);
+            std::string ping = "ping\nid=client\n\n";
+            ::send(sock, ping.c_str(), ping.length(), 0);
+            bool pongSeen = false;
+            std::string pending;
+            char buf[1024];
+            // Répondre à trois ping du serveur
+            for (int answered = 0; answered < 3;) {
+                ssize_t n = ::recv(sock, buf, sizeof(buf), 0);
+                if (n <= 0) break;
+                pending.append(buf, n);
+                size_t end;
+                while ((end = pending.find("\n\n")) != std::string::npos) {
+                    std::string frame = pending.substr(0, end + 2);
+                    pending.erase(0, end + 2);
+                    if (frame.starts_with("pong\nid=client")) pongSeen = true;
+                    if (!frame.starts_with("ping\n")) continue;
+                    std::string pong = "pong" + frame.substr(4);
+                    ::send(sock, pong.c_str(), pong.length(), 0);
+                    answered++;
+                }
+            }
+            CHECK(pongSeen);
+            std::string quit = "quit\n\n";
+            ::send(sock, quit.c_str(), quit.length(), 0);
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            close(sock);
+        });
+        transport.waitForClient();
+        Message msg = transport.receive(); // ping/pong jamais remontés
+        CHECK(msg.getType() == "quit");
+        TransportStats stats = transport.getStats();
+        CHECK(stats.pingsSent >= 3);
+        CHECK(stats.pongsReceived >= 3);
+        CHECK(stats.rtt.count() == stats.pongsReceived);
+        if (client.joinable()) client.join();
+        transport.stop();
+    }
+}
+
+/// Vérifie déconnexion d'un client qui ne répond plus aux ping
+TEST_CASE("UdsTransport missed heartbeats disconnect") {
+    std::string socketPath = "test_heartbeat_miss.sock";
+    UdsTransport transport(socketPath);
+    transport.setHeartbeat(std::chrono::milliseconds(10), 2);
+    if (transport.start()) {
+        int sock = -1;
+        std::thread client([&]() { sock = connectRawClient(socketPath); });
+        transport.waitForClient();
+        client.join();
+        // Client muet: receive doit se débloquer sur déconnexion
+        Message msg = transport.receive();
+        CHECK(msg.getType() == "error");
+        CHECK_FALSE(transport.isClientConnected());
+        CHECK(transport.getStats().missedHeartbeats == 2);
+        close(sock);
+        transport.stop();
+    }
+}
+
+/// Vérifie réception avec délai: expiration, message, puis déconnexion
+TEST_CASE("UdsTransport timed receive") {
+    std::string socketPath = "test_timed.sock";
+    UdsTransport transport(socketPath);
+    if (transport.start()) {
+        int sock = -1;
+        std::thread client([&]() { sock = connectRawClient(socketPath); });
+        transport.waitForClient();
+        client.join();
+        CHECK_FALSE(transport.tryReceive().has_value());
+        auto before = std::chrono::steady_clock::now();
+        CHECK_FALSE(transport.receive(std::chrono::milliseconds(30)));
+        CHECK(std::chrono::steady_clock::now() - before >=
+              std::chrono::milliseconds(30));
+        std::string ready = "ready\n\n";
+        ::send(sock, ready.c_str(), ready.length(), 0);
+        auto msg = transport.receive(std::chrono::seconds(1));
+        CHECK((msg && msg->getType() == "ready"));
+        // Déconnexion: réveil immédiat avec "error", sans attendre le délai
+        close(sock);
+        before = std::chrono::steady_clock::now();
+        msg = transport.receive(std::chrono::seconds(5));
+        CHECK((msg && msg->getType() == "error"));
+        CHECK(std::chrono::steady_clock::now() - before <
+              std::chrono::seconds(1));
+        transport.stop();
+    }
+}
+
+/// Vérifie politique client lent: fusion et délestage des messages
+/// informatifs, coupure au seuil, sans jamais bloquer l'émetteur
+TEST_CASE("UdsTransport slow client backpressure") {
+    std::string socketPath = "test_backpressure.sock";
+    UdsTransport transport(socketPath);
+    transport.setBackpressure({.maxQueued = 4, .disconnectAfter = 8});
+    if (transport.start()) {
+        int sock = -1; // Client qui ne lit jamais
+        std::thread client([&]() { sock = connectRawClient(socketPath); });
+        transport.waitForClient();
+        client.join();
+        std::string big(65536, 'x');
+        int id = 0;
+        auto sendResult = [&]() {
+            transport.send(Message(
+                "result", {{"id", std::to_string(++id)}, {"incorrect", big}}));
+        };
+        auto start = std::chrono::steady_clock::now();
+        // Remplir la socket jusqu'à ce que la file d'envoi se forme
+        while (transport.getStats().queueDepth == 0 && id < 1000) sendResult();
+        transport.send(Message("gametype", {{"id", "note"}}));
+        transport.send(Message("gametype", {{"id", "note"}}));
+        CHECK(transport.getStats().coalesced == 1);
+        while (transport.getStats().queueDepth < 4) sendResult();
+        transport.send(Message("ping", {{"id", "1"}})); // File pleine
+        CHECK(transport.getStats().dropped == 1);
+        sendResult(); // Remplace le `gametype` en attente
+        CHECK(transport.getStats().dropped == 2);
+        CHECK(transport.getStats().queueDepth == 4);
+        for (int i = 0; i < 5; ++i) sendResult(); // Jamais abandonnés
+        CHECK(transport.receive().getType() == "error"); // Coupure
+        CHECK(std::chrono::steady_clock::now() - start <
+              std::chrono::seconds(2));
+        TransportStats stats = transport.getStats();
+        CHECK(stats.overflows == 1);
+        CHECK(stats.peakQueueDepth == 9);
+        CHECK(stats.queueDepth == 0);
+        close(sock);
+        transport.stop();
+    }
+}
+
+/// Vérifie diffusion aux observateurs: messages du client recopiés, hors
+/// battements de cœur, et messages des observateurs ignorés
+TEST_CASE("UdsTransport observers") {
+    std::string socketPath = "test_observers.sock";
+    UdsTransport transport(socketPath);
+    transport.enableObservers(socketPath + ".watch");
+    if (transport.start()) {
+        int observer = connectRawClient(socketPath + ".watch");
+        CHECK(observer >= 0);
+        std::string junk = "quit\n\n"; // Lecture seule: sans effet
+        ::send(observer, junk.c_str(), junk.length(), 0);
+        for (int i = 0; i < 100 && transport.getStats().observers == 0; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        int sock = -1;
+        std::thread client([&]() { sock = connectRawClient(socketPath); });
+        transport.waitForClient();
+        client.join();
+        CHECK(transport.getStats().observers == 1);
+        transport.send(Message("ping", {{"id", "1"}}));
+        transport.send(Message("note", {{"note", "c4"}, {"id", "1"}}));
+        std::string expected = "note\nid=1\nnote=c4\n\n";
+        std::string seen;
+        char buf[256];
+        while (seen.size() < expected.size()) {
+            ssize_t n = ::recv(observer, buf, sizeof(buf), 0);
+            if (n <= 0) break;
+            seen.append(buf, n);
+        }
+        CHECK(seen == expected);
+        CHECK_FALSE(transport.tryReceive().has_value());
+        close(observer);
+        close(sock);
+        transport.stop();
+    }
+}
+
+/// Vérifie adoption d'une socket déjà en écoute (activation par socket)
+/// Clients acceptés avant start(), socket partagée intacte après stop()
+TEST_CASE("UdsTransport inherited listening socket") {
+    std::string socketPath = "test_inherited.sock";
+    unlink(socketPath.c_str());
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+    REQUIRE(bind(listener, (struct sockaddr*)&addr, sizeof(addr)) == 0);
+    REQUIRE(listen(listener, 8) == 0);
+    int manager = dup(listener); // Copie gardée par le gestionnaire
+
+    // Client connecté avant même le démarrage du moteur
+    int early = connectRawClient(socketPath);
+    REQUIRE(early >= 0);
+    std::string hello = "config\ngame=note\n\n";
+    ::send(early, hello.c_str(), hello.length(), 0);
+
+    UdsTransport transport(socketPath);
+    transport.adoptListener(listener);
+    REQUIRE(transport.start());
+    transport.waitForClient();
+    Message received = transport.receive();
+    CHECK(received.getType() == "config");
+    CHECK(received.getField("game") == "note");
+    close(early);
+
+    std::thread stopper([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        transport.stop();
+    });
+    transport.waitForClient(); // Interrompu par stop(), sans client
+    stopper.join();
+    CHECK_FALSE(transport.isClientConnected());
+
+    // Socket du gestionnaire toujours en écoute: nouvelle instance possible
+    int late = connectRawClient(socketPath);
+    CHECK(late >= 0);
+    close(late);
+    close(manager);
+    unlink(socketPath.c_str());
+
+    UdsTransport bad("test_inherited_bad.sock"); // Pas une socket en écoute
+    bad.adoptListener(open("/dev/null", O_RDONLY));
+    CHECK_FALSE(bad.start());
+}
+
+/// Vérifie convention `LISTEN_PID`/`LISTEN_FDS`, réservée au bon processus
+TEST_CASE("UdsTransport listen fds from environment") {
+    setenv("LISTEN_FDS", "1", 1);
+    setenv("LISTEN_PID", std::to_string(getpid() + 1).c_str(), 1);
+    CHECK(UdsTransport::listenFdFromEnv() == -1);
+    CHECK(std::getenv("LISTEN_FDS") == nullptr); // Non transmis aux enfants
+    setenv("LISTEN_FDS", "1", 1);
+    setenv("LISTEN_PID", std::to_string(getpid()).c_str(), 1);
+    CHECK(UdsTransport::listenFdFromEnv() == 3);
+    CHECK(UdsTransport::listenFdFromEnv() == -1); // Déjà consommé
+}
+
+/// Vérifie mise à jour à chaud: socket d'écoute puis client inactif cédés
+/// à la nouvelle instance, sans que le client ne se reconnecte
+TEST_CASE("UdsTransport live handoff") {
+    std::string socketPath = "test_handoff.sock";
+    std::atomic<bool> handedOff{false};
+    UdsTransport old(socketPath);
+    old.enableHandoff(socketPath + ".ctl", [&] { handedOff = true; });
+    REQUIRE(old.start());
+    int client = -1;
+    std::thread connector([&]() { client = connectRawClient(socketPath); });
+    old.waitForClient();
+    connector.join();
+    CHECK_FALSE(old.handOffClient()); // Aucune relève pour l'instant
+
+    UdsTransport next(socketPath);
+    REQUIRE(next.takeOver(socketPath + ".ctl"));
+    REQUIRE(next.start());
+    for (int i = 0; i < 100 && !handedOff; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK(handedOff);
+    old.waitForClient(); // Relève faite: plus aucun accept() ici
+
+    CHECK(old.handOffClient());
+    CHECK_FALSE(old.isClientConnected());
+    next.waitForClient(); // Même connexion, reçue de l'ancienne instance
+    std::string msg = "ready\n\n";
+    ::send(client, msg.c_str(), msg.length(), 0);
+    CHECK(next.receive().getType() == "ready");
+    old.stop(); // Fin de l'ancienne instance, socket d'écoute intacte
+    close(client);
+
+    int late = connectRawClient(socketPath);
+    CHECK(late >= 0);
+    next.waitForClient();
+    CHECK(next.isClientConnected());
+    close(late);
+    next.stop();
+}